@@ -22,6 +22,7 @@
 #include <libdevcore/JSON.h>
 
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/Assertions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -87,6 +88,14 @@ bool parse(Json::CharReaderBuilder& _builder, string const& _input, Json::Value&
 	return reader->parse(_input.c_str(), _input.c_str() + _input.length(), &_json, _errs);
 }
 
+/// @returns the builder for compact JSON writers without indentation
+StreamWriterBuilder const& compactWriterBuilder()
+{
+	static map<string, Json::Value> settings{{"indentation", ""}};
+	static StreamWriterBuilder writerBuilder(settings);
+	return writerBuilder;
+}
+
 } // end anonymous namespace
 
 string jsonPrettyPrint(Json::Value const& _input)
@@ -100,9 +109,7 @@ string jsonPrettyPrint(Json::Value const& _input)
 
 string jsonCompactPrint(Json::Value const& _input)
 {
-	static map<string, Json::Value> settings{{"indentation", ""}};
-	static StreamWriterBuilder writerBuilder(settings);
-	return print(_input, writerBuilder);
+	return print(_input, compactWriterBuilder());
 }
 
 bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /* = nullptr */)
@@ -122,5 +129,105 @@ bool jsonParseFile(string const& _fileName, Json::Value& _json, string *_errs /*
 	return jsonParse(readFileAsString(_fileName), _json, _errs);
 }
 
+JsonWriter::JsonWriter(ostream& _stream):
+	m_stream(&_stream),
+	m_valueWriter(compactWriterBuilder().newStreamWriter())
+{
+}
+
+JsonWriter::JsonWriter(Json::Value& _root):
+	m_root(&_root)
+{
+}
+
+JsonWriter::~JsonWriter() = default;
+
+void JsonWriter::beginObject()
+{
+	assertThrow(!m_rootStarted, Exception, "Root object already started.");
+	m_rootStarted = true;
+	if (m_stream)
+	{
+		*m_stream << "{";
+		m_hasMembers.push_back(false);
+	}
+	else
+	{
+		*m_root = Json::objectValue;
+		m_objects.push_back(m_root);
+	}
+}
+
+void JsonWriter::beginObject(string const& _key)
+{
+	if (m_stream)
+	{
+		writeKey(_key);
+		*m_stream << "{";
+		m_hasMembers.push_back(false);
+	}
+	else
+	{
+		assertThrow(!m_objects.empty(), Exception, "No open object.");
+		m_started = true;
+		Json::Value& object = (*m_objects.back())[_key] = Json::objectValue;
+		m_objects.push_back(&object);
+	}
+}
+
+void JsonWriter::endObject()
+{
+	if (m_stream)
+	{
+		assertThrow(!m_hasMembers.empty(), Exception, "No open object.");
+		*m_stream << "}";
+		m_hasMembers.pop_back();
+	}
+	else
+	{
+		assertThrow(!m_objects.empty(), Exception, "No open object.");
+		m_objects.pop_back();
+	}
+}
+
+void JsonWriter::write(string const& _key, Json::Value _value)
+{
+	if (m_stream)
+	{
+		writeKey(_key);
+		m_valueWriter->write(_value, m_stream);
+	}
+	else
+	{
+		assertThrow(!m_objects.empty(), Exception, "No open object.");
+		m_started = true;
+		(*m_objects.back())[_key] = std::move(_value);
+	}
+}
+
+void JsonWriter::writeMembers(Json::Value const& _object)
+{
+	for (string const& member: _object.getMemberNames())
+		write(member, _object[member]);
+}
+
+void JsonWriter::close()
+{
+	while (m_stream ? !m_hasMembers.empty() : !m_objects.empty())
+		endObject();
+}
+
+void JsonWriter::writeKey(string const& _key)
+{
+	assertThrow(!m_hasMembers.empty(), Exception, "No open object.");
+	if (m_hasMembers.back())
+		*m_stream << ",";
+	m_hasMembers.back() = true;
+	m_started = true;
+	// Use the value writer for the key as well to get identical escaping.
+	m_valueWriter->write(Json::Value(_key), m_stream);
+	*m_stream << ":";
+}
+
 
 } // namespace dev
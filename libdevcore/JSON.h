@@ -24,7 +24,10 @@
 
 #include <json/json.h>
 
+#include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace dev {
 
@@ -55,4 +58,52 @@ bool jsonParse(std::string const& _input, Json::Value& _json, std::string* _errs
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseFile(std::string const& _fileName, Json::Value& _json, std::string* _errs = nullptr);
 
+/**
+ * Writes a JSON object incrementally, either directly to an output stream in compact form
+ * or into a Json::Value.
+ *
+ * Streaming allows large documents to be emitted member by member without ever materialising
+ * the whole document. The streamed output is identical to what jsonCompactPrint would produce
+ * for the equivalent Json::Value as long as the members of each object are written in sorted
+ * key order, which is the responsibility of the caller.
+ */
+class JsonWriter
+{
+public:
+	/// Creates a writer that streams compact JSON into @a _stream.
+	explicit JsonWriter(std::ostream& _stream);
+	/// Creates a writer that stores the document in @a _root.
+	explicit JsonWriter(Json::Value& _root);
+	~JsonWriter();
+
+	/// Starts the root object. Has to be called exactly once before writing any member.
+	void beginObject();
+	/// Starts a new object as member @a _key of the current object.
+	void beginObject(std::string const& _key);
+	/// Closes the current object.
+	void endObject();
+	/// Writes @a _value as member @a _key of the current object.
+	void write(std::string const& _key, Json::Value _value);
+	/// Writes all members of the object @a _object into the current object.
+	void writeMembers(Json::Value const& _object);
+	/// Closes all objects that are still open.
+	void close();
+
+	/// @returns true if any member has been written so far.
+	bool started() const { return m_started; }
+
+private:
+	void writeKey(std::string const& _key);
+
+	std::ostream* m_stream = nullptr;
+	std::unique_ptr<Json::StreamWriter> m_valueWriter;
+	/// For each open object in streaming mode, whether it already has a member.
+	std::vector<bool> m_hasMembers;
+	Json::Value* m_root = nullptr;
+	/// Stack of open objects when writing into a Json::Value.
+	std::vector<Json::Value*> m_objects;
+	bool m_rootStarted = false;
+	bool m_started = false;
+};
+
 }
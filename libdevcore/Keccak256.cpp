@@ -21,6 +21,7 @@
 
 #include <libdevcore/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -183,4 +184,35 @@ h256 keccak256(bytesConstRef _input)
 	return output;
 }
 
+void Keccak256Hasher::update(bytesConstRef _input)
+{
+	uint8_t const* in = _input.data();
+	size_t length = _input.size();
+	while (length > 0)
+	{
+		size_t chunk = min(length, c_rate - m_offset);
+		xorin(m_state + m_offset, in, chunk);
+		m_offset += chunk;
+		in += chunk;
+		length -= chunk;
+		if (m_offset == c_rate)
+		{
+			P(m_state);
+			m_offset = 0;
+		}
+	}
+}
+
+h256 Keccak256Hasher::digest() const
+{
+	uint8_t a[Plen];
+	memcpy(a, m_state, Plen);
+	a[m_offset] ^= 0x01;
+	a[c_rate - 1] ^= 0x80;
+	P(a);
+	h256 output;
+	setout(a, output.data(), output.size);
+	return output;
+}
+
 }
@@ -42,4 +42,25 @@ inline h256 keccak256(std::string const& _input) { return keccak256(bytesConstRe
 /// Calculate Keccak-256 hash of the given input (presented as a FixedHash), returns a 256-bit hash.
 template<unsigned N> inline h256 keccak256(FixedHash<N> const& _input) { return keccak256(_input.ref()); }
 
+/// Incremental Keccak-256: the hash of the concatenation of all inputs given to update().
+/// Copies continue independently from the state at the time of the copy, so that hashes
+/// of inputs with a common prefix can share the work of absorbing that prefix.
+class Keccak256Hasher
+{
+public:
+	void update(bytesConstRef _input);
+	void update(std::string const& _input) { update(bytesConstRef(_input)); }
+
+	/// @returns the hash of the input so far. Does not modify the state.
+	h256 digest() const;
+
+private:
+	/// 200 - (256 / 4), see keccak256().
+	static size_t constexpr c_rate = 136;
+
+	uint8_t m_state[200] = {0};
+	/// Number of bytes absorbed into the current block.
+	size_t m_offset = 0;
+};
+
 }
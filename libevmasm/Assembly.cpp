@@ -24,6 +24,7 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/SuperOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
@@ -37,8 +38,22 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
+AssemblyItem Assembly::newJumpTable(vector<AssemblyItem> const& _tags)
+{
+	h256 id(dev::keccak256("jumptable" + to_string(m_jumpTables.size())));
+	vector<size_t>& table = m_jumpTables[id];
+	for (AssemblyItem const& tag: _tags)
+	{
+		assertThrow(tag.type() == Tag || tag.type() == PushTag, AssemblyException, "Jump table entry is not a tag.");
+		assertThrow(tag.splitForeignPushTag().first == size_t(-1), AssemblyException, "Foreign tag in jump table.");
+		table.push_back(size_t(tag.data()));
+	}
+	return AssemblyItem(PushData, id);
+}
+
 void Assembly::append(Assembly const& _a)
 {
+	assertThrow(_a.m_jumpTables.empty(), AssemblyException, "Cannot append an assembly with jump tables.");
 	auto newDeposit = m_deposit + _a.deposit();
 	for (AssemblyItem i: _a.m_items)
 	{
@@ -101,6 +116,8 @@ unsigned Assembly::bytesRequired(unsigned subTagSize) const
 		unsigned ret = 1;
 		for (auto const& i: m_data)
 			ret += i.second.size();
+		for (auto const& table: m_jumpTables)
+			ret += table.second.size() * jumpTableEntrySize;
 
 		for (AssemblyItem const& i: m_items)
 			ret += i.bytesRequired(tagSize);
@@ -216,12 +233,19 @@ void Assembly::assemblyStream(ostream& _out, string const& _prefix, StringMap co
 		f.feed(i);
 	f.flush();
 
-	if (!m_data.empty() || !m_subs.empty())
+	if (!m_data.empty() || !m_jumpTables.empty() || !m_subs.empty())
 	{
 		_out << _prefix << "stop" << endl;
 		for (auto const& i: m_data)
 			if (u256(i.first) >= m_subs.size())
 				_out << _prefix << "data_" << toHex(u256(i.first)) << " " << toHex(i.second) << endl;
+		for (auto const& table: m_jumpTables)
+		{
+			_out << _prefix << "data_" << toHex(u256(table.first)) << " jumptable(";
+			for (size_t i = 0; i < table.second.size(); ++i)
+				_out << (i > 0 ? ", " : "") << "tag_" << table.second[i];
+			_out << ")" << endl;
+		}
 
 		for (size_t i = 0; i < m_subs.size(); ++i)
 		{
@@ -327,6 +351,17 @@ Json::Value Assembly::assemblyJSON(StringMap const& _sourceCodes) const
 		}
 	}
 
+	if (!m_jumpTables.empty())
+	{
+		Json::Value& jumpTables = root[".jumpTables"] = Json::objectValue;
+		for (auto const& table: m_jumpTables)
+		{
+			Json::Value& tags = jumpTables[toStringInHex(u256(table.first))] = Json::arrayValue;
+			for (size_t tag: table.second)
+				tags.append(dev::toString(tag));
+		}
+	}
+
 	if (!m_data.empty() || !m_subs.empty())
 	{
 		Json::Value& data = root[".data"] = Json::objectValue;
@@ -415,8 +450,12 @@ map<u256, u256> Assembly::optimiseInternal(
 
 		if (_settings.runJumpdestRemover)
 		{
+			// Tags used in jump tables have to be kept, too.
+			set<size_t> referencedTags = _tagsReferencedFromOutside;
+			for (auto const& table: m_jumpTables)
+				referencedTags += table.second;
 			JumpdestRemover jumpdestOpt{m_items};
-			if (jumpdestOpt.optimise(_tagsReferencedFromOutside))
+			if (jumpdestOpt.optimise(referencedTags))
 				count++;
 		}
 
@@ -452,6 +491,10 @@ map<u256, u256> Assembly::optimiseInternal(
 					if (_tagsReferencedFromOutside.erase(size_t(replacement.first)))
 						_tagsReferencedFromOutside.insert(size_t(replacement.second));
 				}
+				for (auto& table: m_jumpTables)
+					for (size_t& tag: table.second)
+						while (dedup.replacedTags().count(tag))
+							tag = size_t(dedup.replacedTags().at(tag));
 				count++;
 			}
 		}
@@ -504,6 +547,13 @@ map<u256, u256> Assembly::optimiseInternal(
 				count++;
 			}
 		}
+
+		if (_settings.runSuperOptimiser)
+		{
+			SuperOptimiser superOpt{m_items};
+			if (superOpt.optimise())
+				count++;
+		}
 	}
 
 	if (_settings.runConstantOptimiser)
@@ -640,7 +690,7 @@ LinkerObject const& Assembly::assemble() const
 		}
 	}
 
-	if (!m_subs.empty() || !m_data.empty() || !m_auxiliaryData.empty())
+	if (!m_subs.empty() || !m_data.empty() || !m_jumpTables.empty() || !m_auxiliaryData.empty())
 		// Append an INVALID here to help tests find miscompilation.
 		ret.bytecode.push_back(uint8_t(Instruction::INVALID));
 
@@ -685,6 +735,27 @@ LinkerObject const& Assembly::assemble() const
 		}
 		ret.bytecode += dataItem.second;
 	}
+	for (auto const& table: m_jumpTables)
+	{
+		auto references = dataRef.equal_range(table.first);
+		if (references.first == references.second)
+			continue;
+		for (auto ref = references.first; ref != references.second; ++ref)
+		{
+			bytesRef r(ret.bytecode.data() + ref->second, bytesPerDataRef);
+			toBigEndian(ret.bytecode.size(), r);
+		}
+		for (size_t tagId: table.second)
+		{
+			assertThrow(tagId < m_tagPositionsInBytecode.size(), AssemblyException, "Reference to non-existing tag.");
+			size_t pos = m_tagPositionsInBytecode[tagId];
+			assertThrow(pos != size_t(-1), AssemblyException, "Reference to tag without position.");
+			assertThrow(dev::bytesRequired(pos) <= jumpTableEntrySize, AssemblyException, "Tag too large for jump table.");
+			ret.bytecode.resize(ret.bytecode.size() + jumpTableEntrySize);
+			bytesRef r(&ret.bytecode.back() + 1 - jumpTableEntrySize, jumpTableEntrySize);
+			toBigEndian(pos, r);
+		}
+	}
 
 	ret.bytecode += m_auxiliaryData;
 
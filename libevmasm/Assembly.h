@@ -51,6 +51,11 @@ public:
 	AssemblyItem namedTag(std::string const& _name);
 	AssemblyItem newData(bytes const& _data) { h256 h(dev::keccak256(asString(_data))); m_data[h] = _data; return AssemblyItem(PushData, h); }
 	bytes const& data(h256 const& _i) const { return m_data.at(_i); }
+	/// Creates a jump table, i.e. a table in the data section which contains the code offsets
+	/// of the given tags, using jumpTableEntrySize bytes (big endian) per entry.
+	/// @returns the item that pushes the offset of the table.
+	AssemblyItem newJumpTable(std::vector<AssemblyItem> const& _tags);
+	JumpTables const& jumpTables() const { return m_jumpTables; }
 	AssemblyItem newSub(AssemblyPointer const& _sub) { m_subs.push_back(_sub); return AssemblyItem(PushSub, m_subs.size() - 1); }
 	Assembly const& sub(size_t _sub) const { return *m_subs.at(_sub); }
 	Assembly& sub(size_t _sub) { return *m_subs.at(_sub); }
@@ -107,6 +112,7 @@ public:
 		bool runDeduplicate = false;
 		bool runCSE = false;
 		bool runConstantOptimiser = false;
+		bool runSuperOptimiser = false;
 		langutil::EVMVersion evmVersion;
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
@@ -163,12 +169,17 @@ private:
 	static Json::Value createJsonValue(std::string _name, int _begin, int _end, std::string _value = std::string(), std::string _jumpType = std::string());
 	static std::string toStringInHex(u256 _value);
 
+public:
+	/// Number of bytes of each entry of a jump table.
+	static unsigned constexpr jumpTableEntrySize = 2;
+
 protected:
 	/// 0 is reserved for exception
 	unsigned m_usedTags = 1;
 	std::map<std::string, size_t> m_namedTags;
 	AssemblyItems m_items;
 	std::map<h256, bytes> m_data;
+	JumpTables m_jumpTables;
 	/// Data that is appended to the very end of the contract.
 	bytes m_auxiliaryData;
 	std::vector<std::shared_ptr<Assembly>> m_subs;
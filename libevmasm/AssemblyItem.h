@@ -26,7 +26,9 @@
 #include <liblangutil/SourceLocation.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
+#include <libdevcore/FixedHash.h>
 #include <iostream>
+#include <map>
 #include <sstream>
 
 namespace dev
@@ -158,6 +160,9 @@ private:
 };
 
 using AssemblyItems = std::vector<AssemblyItem>;
+/// Jump tables of an assembly, i.e. the tags they refer to, indexed by the data hash
+/// that is pushed to access the table.
+using JumpTables = std::map<h256, std::vector<size_t>>;
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
 {
@@ -154,7 +154,13 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 				bool invStor = SemanticInformation::invalidatesStorage(_item.instruction());
 				// We could be a bit more fine-grained here (CALL only invalidates part of
 				// memory, etc), but we do not for now.
-				if (invMem)
+				if (
+					instruction == Instruction::CALLDATACOPY ||
+					instruction == Instruction::CODECOPY ||
+					instruction == Instruction::RETURNDATACOPY
+				)
+					resetMemoryArea(arguments[0], arguments[2]);
+				else if (invMem)
 					resetMemory();
 				if (invStor)
 					resetStorage();
@@ -353,6 +359,25 @@ ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const&
 	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
+void KnownState::resetMemoryArea(Id _start, Id _length)
+{
+	u256 const* start = m_expressionClasses->knownConstant(_start);
+	u256 const* length = m_expressionClasses->knownConstant(_length);
+	if (!start || !length)
+	{
+		resetMemory();
+		return;
+	}
+	bigint end = bigint(*start) + *length;
+	decltype(m_memoryContent) memoryContents;
+	// copy over values at slots that are known to lie outside of the area
+	for (auto const& memoryItem: m_memoryContent)
+		if (u256 const* slot = m_expressionClasses->knownConstant(memoryItem.first))
+			if (*length == 0 || bigint(*slot) + 32 <= *start || *slot >= end)
+				memoryContents.insert(memoryItem);
+	m_memoryContent = move(memoryContents);
+}
+
 KnownState::Id KnownState::applyKeccak256(
 	Id _start,
 	Id _length,
@@ -156,6 +156,9 @@ private:
 	StoreOperation storeInMemory(Id _slot, Id _value, langutil::SourceLocation const& _location);
 	/// Retrieves the current value at the given slot in memory or creates a new special mload class.
 	Id loadFromMemory(Id _slot, langutil::SourceLocation const& _location);
+	/// Deletes all memory information that might be overwritten by a write to the area of
+	/// @a _length bytes starting at @a _start. Resets all memory information if the area is not known.
+	void resetMemoryArea(Id _start, Id _length);
 	/// Finds or creates a new expression that applies the Keccak-256 hash function to the contents in memory.
 	Id applyKeccak256(Id _start, Id _length, langutil::SourceLocation const& _location);
 
@@ -27,8 +27,8 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, JumpTables _jumpTables):
+	m_items(_items), m_evmVersion(_evmVersion), m_jumpTables(move(_jumpTables))
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -82,6 +82,8 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 		return gas;
 
 	set<u256> jumpTags;
+	// Tags of the jump tables accessed in the current block.
+	set<u256> jumpTableTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
 		bool branchStops = false;
@@ -94,11 +96,16 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 			if (path->visitedJumpdests.count(index))
 				return GasMeter::GasConsumption::infinite();
 			path->visitedJumpdests.insert(index);
+			jumpTableTags.clear();
 		}
+		else if (item.type() == PushData && m_jumpTables.count(h256(item.data())))
+			jumpTableTags += m_jumpTables.at(h256(item.data()));
 		else if (item == AssemblyItem(Instruction::JUMP))
 		{
 			branchStops = true;
 			jumpTags = state->tagsInExpression(state->relativeStackElement(0));
+			if (jumpTags.empty())
+				jumpTags = jumpTableTags;
 			if (jumpTags.empty()) // unknown jump destination
 				return GasMeter::GasConsumption::infinite();
 		}
@@ -53,7 +53,14 @@ struct GasPath
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// @param _jumpTables the jump tables of the assembly. A jump to an unknown destination
+	/// after the offset of a jump table was pushed in the same block is assumed to go to
+	/// one of the tags of the table.
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		JumpTables _jumpTables = JumpTables()
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -61,10 +68,11 @@ public:
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		JumpTables _jumpTables = JumpTables()
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, std::move(_jumpTables)).estimateMax(_startIndex, _state);
 	}
 
 private:
@@ -82,6 +90,7 @@ private:
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	JumpTables m_jumpTables;
 };
 
 }
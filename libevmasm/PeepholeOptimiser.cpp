@@ -24,6 +24,8 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <deque>
+
 using namespace std;
 using namespace dev::eth;
 using namespace dev;
@@ -33,9 +35,16 @@ using namespace dev;
 namespace
 {
 
+/// Size of the largest window any of the simple methods below matches on.
+size_t const c_maxWindowSize = 4;
+
+using ItemIterator = std::deque<AssemblyItem>::const_iterator;
+
 struct OptimiserState
 {
-	AssemblyItems const& items;
+	/// Items that still have to be processed.
+	std::deque<AssemblyItem> items;
+	/// Number of items from the front of ``items`` consumed by the applied method.
 	size_t i;
 	std::back_insert_iterator<AssemblyItems> out;
 };
@@ -47,7 +56,7 @@ struct ApplyRule
 template <class Method>
 struct ApplyRule<Method, 4>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(ItemIterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _in[2], _in[3], _out);
 	}
@@ -55,7 +64,7 @@ struct ApplyRule<Method, 4>
 template <class Method>
 struct ApplyRule<Method, 3>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(ItemIterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _in[2], _out);
 	}
@@ -63,7 +72,7 @@ struct ApplyRule<Method, 3>
 template <class Method>
 struct ApplyRule<Method, 2>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(ItemIterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _in[1], _out);
 	}
@@ -71,7 +80,7 @@ struct ApplyRule<Method, 2>
 template <class Method>
 struct ApplyRule<Method, 1>
 {
-	static bool applyRule(AssemblyItems::const_iterator _in, std::back_insert_iterator<AssemblyItems> _out)
+	static bool applyRule(ItemIterator _in, std::back_insert_iterator<AssemblyItems> _out)
 	{
 		return Method::applySimple(_in[0], _out);
 	}
@@ -95,15 +104,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -162,6 +162,76 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush, 2>
 	}
 };
 
+/// Removes a swap of two copies of the same value.
+struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap, 2>
+{
+	static bool applySimple(AssemblyItem const& _dup, AssemblyItem const& _swap, std::back_insert_iterator<AssemblyItems> _out)
+	{
+		if (
+			SemanticInformation::isDupInstruction(_dup) &&
+			SemanticInformation::isSwapInstruction(_swap) &&
+			getDupNumber(_dup.instruction()) == getSwapNumber(_swap.instruction())
+		)
+		{
+			*_out = _dup;
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
+struct DoubleNot: SimplePeepholeOptimizerMethod<DoubleNot, 2>
+{
+	static bool applySimple(AssemblyItem const& _not1, AssemblyItem const& _not2, std::back_insert_iterator<AssemblyItems>)
+	{
+		return _not1 == Instruction::NOT && _not2 == Instruction::NOT;
+	}
+};
+
+struct TripleIsZero: SimplePeepholeOptimizerMethod<TripleIsZero, 3>
+{
+	static bool applySimple(
+		AssemblyItem const& _iszero1,
+		AssemblyItem const& _iszero2,
+		AssemblyItem const& _iszero3,
+		std::back_insert_iterator<AssemblyItems> _out
+	)
+	{
+		if (
+			_iszero1 == Instruction::ISZERO &&
+			_iszero2 == Instruction::ISZERO &&
+			_iszero3 == Instruction::ISZERO
+		)
+		{
+			*_out = _iszero3;
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
+/// Removes operations that do not change the value below the top of the stack
+/// because the top of the stack is zero, e.g. ``PUSH 0 ADD`` or ``PUSH 0 SHL``.
+struct ZeroIdentity: SimplePeepholeOptimizerMethod<ZeroIdentity, 2>
+{
+	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems>)
+	{
+		static set<Instruction> const identityOps{
+			Instruction::ADD,
+			Instruction::OR,
+			Instruction::XOR,
+			Instruction::SHL,
+			Instruction::SHR,
+			Instruction::SAR
+		};
+		return
+			_push.type() == Push && _push.data() == 0 &&
+			_op.type() == Operation && identityOps.count(_op.instruction());
+	}
+};
+
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap, 2>
 {
 	static bool applySimple(AssemblyItem const& _swap, AssemblyItem const& _op, std::back_insert_iterator<AssemblyItems> _out)
@@ -331,16 +401,17 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
+/// Applies the first method that matches at the front of the remaining items.
+/// @returns false if none of them matched.
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
 size_t numberOfPops(AssemblyItems const& _items)
@@ -352,14 +423,37 @@ size_t numberOfPops(AssemblyItems const& _items)
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
+	m_optimisedItems.clear();
+	OptimiserState state{{m_items.begin(), m_items.end()}, 0, std::back_inserter(m_optimisedItems)};
+	while (!state.items.empty())
+	{
+		size_t outputSize = m_optimisedItems.size();
+		state.i = 0;
+		bool changed = applyMethods(
 			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
+			PushPop(), OpPop(), DoublePush(), DoubleSwap(), DupSwap(), DoubleNot(),
+			CommutativeSwap(), SwapComparison(), ZeroIdentity(),
+			IsZeroIsZeroJumpI(), TripleIsZero(), JumpToNext(), UnreachableCode(),
+			TagConjunctions(), TruthyAnd()
 		);
+		if (changed)
+		{
+			state.items.erase(state.items.begin(), state.items.begin() + state.i);
+			// Move the replacement and the items in front of it back to the input,
+			// so that the methods can match on the changed code in the same pass.
+			size_t backtrack = min(
+				m_optimisedItems.size(),
+				m_optimisedItems.size() - outputSize + c_maxWindowSize - 1
+			);
+			state.items.insert(state.items.begin(), m_optimisedItems.end() - backtrack, m_optimisedItems.end());
+			m_optimisedItems.erase(m_optimisedItems.end() - backtrack, m_optimisedItems.end());
+		}
+		else
+		{
+			m_optimisedItems.push_back(std::move(state.items.front()));
+			state.items.pop_front();
+		}
+	}
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			eth::bytesRequired(m_optimisedItems, 3) < eth::bytesRequired(m_items, 3) ||
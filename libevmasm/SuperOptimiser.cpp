@@ -0,0 +1,247 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file SuperOptimiser.cpp
+ * Replaces short straight-line sequences by cheaper equivalent ones found by exhaustive search.
+ */
+
+#include <libevmasm/SuperOptimiser.h>
+
+#include <libevmasm/AssemblyItem.h>
+#include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/KnownState.h>
+#include <libevmasm/SemanticInformation.h>
+
+#include <map>
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+/// @returns true if the item only operates on the stack and the values it
+/// produces only depend on its arguments and on call-constant state.
+bool isStraightLineItem(AssemblyItem const& _item)
+{
+	if (_item.type() == Push)
+		return true;
+	if (_item.type() != Operation)
+		return false;
+	Instruction instruction = _item.instruction();
+	if (
+		SemanticInformation::isDupInstruction(_item) ||
+		SemanticInformation::isSwapInstruction(_item) ||
+		instruction == Instruction::POP
+	)
+		return true;
+	// The gas costs of EXP depend on its arguments.
+	return
+		SemanticInformation::movable(instruction) &&
+		instruction != Instruction::MLOAD &&
+		instruction != Instruction::EXP &&
+		instructionInfo(instruction).ret <= 1;
+}
+
+/// @returns the number of stack elements accessed by the item.
+int stackAccess(AssemblyItem const& _item)
+{
+	return _item.type() == Push ? 0 : instructionInfo(_item.instruction()).args;
+}
+
+/// @returns the difference of the stack height after and before the item.
+int stackChange(AssemblyItem const& _item)
+{
+	if (_item.type() == Push)
+		return 1;
+	InstructionInfo info = instructionInfo(_item.instruction());
+	return info.ret - info.args;
+}
+
+struct Cost
+{
+	unsigned gas = 0;
+	unsigned bytes = 0;
+
+	Cost operator+(Cost const& _other) const { return {gas + _other.gas, bytes + _other.bytes}; }
+	bool notMoreExpensiveThan(Cost const& _other) const { return gas <= _other.gas && bytes <= _other.bytes; }
+	bool cheaperThan(Cost const& _other) const
+	{
+		return notMoreExpensiveThan(_other) && (gas < _other.gas || bytes < _other.bytes);
+	}
+};
+
+Cost costOf(AssemblyItem const& _item)
+{
+	return {
+		GasMeter::runGas(_item.type() == Push ? Instruction::PUSH1 : _item.instruction()),
+		_item.bytesRequired(3)
+	};
+}
+
+/// Depth-first search over all sequences built from the stack operations and the
+/// pushes and instructions of the original sequence.
+class ReplacementSearch
+{
+public:
+	explicit ReplacementSearch(AssemblyItems const& _sequence):
+		m_classes(make_shared<ExpressionClasses>()),
+		m_target(m_classes)
+	{
+		int height = 0;
+		for (AssemblyItem const& item: _sequence)
+		{
+			m_depth = max(m_depth, stackAccess(item) - height);
+			height += stackChange(item);
+			m_originalCost = m_originalCost + costOf(item);
+			m_target.feedItem(item);
+			if (
+				!SemanticInformation::isDupInstruction(item) &&
+				!SemanticInformation::isSwapInstruction(item) &&
+				item != Instruction::POP &&
+				find(m_alphabet.begin(), m_alphabet.end(), item) == m_alphabet.end()
+			)
+				m_alphabet.emplace_back(item.type() == Push ? AssemblyItem(item.data()) : AssemblyItem(item.instruction()));
+		}
+		m_alphabet.emplace_back(Instruction::POP);
+		for (int i = 1; i <= min(16, m_depth + int(SuperOptimiser::c_maxReplacementLength)); ++i)
+		{
+			m_alphabet.emplace_back(dupInstruction(unsigned(i)));
+			m_alphabet.emplace_back(swapInstruction(unsigned(i)));
+		}
+	}
+
+	boost::optional<AssemblyItems> run()
+	{
+		search(KnownState(m_classes), 0, Cost{});
+		return m_best;
+	}
+
+private:
+	void search(KnownState const& _state, int _height, Cost const& _cost)
+	{
+		if (_cost.cheaperThan(m_best ? m_bestCost : m_originalCost))
+		{
+			KnownState state = _state;
+			if (equivalentToTarget(state))
+			{
+				m_best = m_candidate;
+				m_bestCost = _cost;
+			}
+		}
+		if (m_candidate.size() >= SuperOptimiser::c_maxReplacementLength)
+			return;
+		for (AssemblyItem const& item: m_alphabet)
+		{
+			// Do not access stack elements the original sequence does not access.
+			if (_height - stackAccess(item) < -m_depth)
+				continue;
+			Cost cost = _cost + costOf(item);
+			if (!cost.notMoreExpensiveThan(m_originalCost))
+				continue;
+			KnownState state = _state;
+			state.feedItem(item);
+			m_candidate.push_back(item);
+			search(state, _height + stackChange(item), cost);
+			m_candidate.pop_back();
+		}
+	}
+
+	bool equivalentToTarget(KnownState& _state)
+	{
+		if (_state.stackHeight() != m_target.stackHeight())
+			return false;
+		for (int height = 1 - m_depth; height <= m_target.stackHeight(); ++height)
+			if (_state.stackElement(height, {}) != m_target.stackElement(height, {}))
+				return false;
+		return true;
+	}
+
+	std::shared_ptr<ExpressionClasses> m_classes;
+	/// State after the original sequence.
+	KnownState m_target;
+	/// Number of stack elements below the initial stack height accessed by the original sequence.
+	int m_depth = 0;
+	Cost m_originalCost;
+	/// Items the candidates are built from. Must not be modified during the search,
+	/// since m_classes references them.
+	AssemblyItems m_alphabet;
+	AssemblyItems m_candidate;
+	boost::optional<AssemblyItems> m_best;
+	Cost m_bestCost;
+};
+
+boost::optional<AssemblyItems> cachedReplacement(AssemblyItems const& _sequence)
+{
+	// The replacement only depends on the sequence itself, so the results of the
+	// (expensive) search are shared between all assemblies.
+	static map<string, boost::optional<AssemblyItems>> cache;
+
+	ostringstream key;
+	for (AssemblyItem const& item: _sequence)
+		key << item << " ";
+	auto it = cache.find(key.str());
+	if (it == cache.end())
+		it = cache.emplace(key.str(), SuperOptimiser::findReplacement(_sequence)).first;
+	return it->second;
+}
+
+}
+
+boost::optional<AssemblyItems> SuperOptimiser::findReplacement(AssemblyItems const& _sequence)
+{
+	return ReplacementSearch{_sequence}.run();
+}
+
+bool SuperOptimiser::optimise()
+{
+	AssemblyItems optimisedItems;
+	bool changed = false;
+	for (size_t i = 0; i < m_items.size();)
+	{
+		size_t runLength = 0;
+		while (
+			runLength < c_maxSequenceLength &&
+			i + runLength < m_items.size() &&
+			isStraightLineItem(m_items[i + runLength])
+		)
+			runLength++;
+
+		bool replaced = false;
+		// Prefer replacing longer sequences.
+		for (size_t length = runLength; length >= 2 && !replaced; --length)
+			if (auto replacement = cachedReplacement(AssemblyItems(m_items.begin() + i, m_items.begin() + i + length)))
+			{
+				for (AssemblyItem item: *replacement)
+				{
+					item.setLocation(m_items[i].location());
+					optimisedItems.emplace_back(move(item));
+				}
+				i += length;
+				replaced = true;
+				changed = true;
+			}
+		if (!replaced)
+			optimisedItems.push_back(m_items[i++]);
+	}
+	if (changed)
+		m_items = move(optimisedItems);
+	return changed;
+}
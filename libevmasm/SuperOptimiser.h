@@ -0,0 +1,70 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * @file SuperOptimiser.h
+ * Replaces short straight-line sequences by cheaper equivalent ones found by exhaustive search.
+ */
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace dev
+{
+namespace eth
+{
+class AssemblyItem;
+using AssemblyItems = std::vector<AssemblyItem>;
+
+/**
+ * Optimiser that searches for cheaper replacements of short sequences of pushes, stack
+ * operations and functional instructions (arithmetic, comparison, ...) inside basic blocks.
+ *
+ * All sequences up to a small length built from stack operations and the instructions
+ * and constants of the original sequence are enumerated. A candidate is equivalent to the
+ * original sequence if feeding both into a KnownState results in the same stack height and
+ * the same expression classes on the stack. A replacement is only used if it is cheaper in
+ * runtime gas or code size and not more expensive in the other.
+ *
+ * Results of the search do not depend on the surrounding code and are cached for the
+ * lifetime of the process.
+ */
+class SuperOptimiser
+{
+public:
+	/// Maximum length of a sequence that is replaced.
+	static size_t const c_maxSequenceLength = 4;
+	/// Maximum length of a replacement.
+	static size_t const c_maxReplacementLength = 3;
+
+	explicit SuperOptimiser(AssemblyItems& _items): m_items(_items) {}
+
+	/// @returns true iff any sequence was replaced.
+	bool optimise();
+
+	/// @returns the cheapest sequence equivalent to @a _sequence if it is cheaper than
+	/// @a _sequence itself.
+	static boost::optional<AssemblyItems> findReplacement(AssemblyItems const& _sequence);
+
+private:
+	AssemblyItems& m_items;
+};
+
+}
+}
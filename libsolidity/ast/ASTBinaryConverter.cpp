@@ -0,0 +1,348 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Converts the AST into a compact binary format.
+ */
+
+#include <libsolidity/ast/ASTBinaryConverter.h>
+
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/ast/AST.h>
+
+#include <cstring>
+#include <unordered_map>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace
+{
+
+enum class Tag: uint8_t
+{
+	Null,
+	False,
+	True,
+	Int,
+	UInt,
+	Double,
+	String,
+	Array,
+	Object,
+	SourceLocation
+};
+
+uint64_t zigzag(int64_t _value)
+{
+	return (uint64_t(_value) << 1) ^ uint64_t(_value >> 63);
+}
+
+int64_t unzigzag(uint64_t _value)
+{
+	return int64_t(_value >> 1) ^ -int64_t(_value & 1);
+}
+
+class Encoder
+{
+public:
+	bytes encode(Json::Value const& _json)
+	{
+		encodeValue(_json);
+
+		bytes output{'S', 'A', 'S', 'T', ASTBinaryConverter::version};
+		appendUnsigned(output, m_strings.size());
+		for (string const* str: m_strings)
+		{
+			appendUnsigned(output, str->size());
+			output += asBytes(*str);
+		}
+		output += m_body;
+		return output;
+	}
+
+private:
+	void encodeValue(Json::Value const& _value)
+	{
+		switch (_value.type())
+		{
+		case Json::nullValue:
+			appendTag(Tag::Null);
+			break;
+		case Json::booleanValue:
+			appendTag(_value.asBool() ? Tag::True : Tag::False);
+			break;
+		case Json::intValue:
+			appendTag(Tag::Int);
+			appendUnsigned(m_body, zigzag(_value.asInt64()));
+			break;
+		case Json::uintValue:
+			appendTag(Tag::UInt);
+			appendUnsigned(m_body, _value.asUInt64());
+			break;
+		case Json::realValue:
+		{
+			appendTag(Tag::Double);
+			double value = _value.asDouble();
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			for (size_t i = 0; i < 8; ++i)
+				m_body.push_back(uint8_t(bits >> (8 * i)));
+			break;
+		}
+		case Json::stringValue:
+			if (!encodeSourceLocation(_value.asString()))
+			{
+				appendTag(Tag::String);
+				appendUnsigned(m_body, intern(_value.asString()));
+			}
+			break;
+		case Json::arrayValue:
+			appendTag(Tag::Array);
+			appendUnsigned(m_body, _value.size());
+			for (auto const& element: _value)
+				encodeValue(element);
+			break;
+		case Json::objectValue:
+			appendTag(Tag::Object);
+			appendUnsigned(m_body, _value.size());
+			for (auto it = _value.begin(); it != _value.end(); ++it)
+			{
+				appendUnsigned(m_body, intern(it.name()));
+				encodeValue(*it);
+			}
+			break;
+		}
+	}
+
+	/// Encodes strings of the form "<start>:<length>:<source index>" as integers.
+	/// @returns false if @a _value is not a source location that can be restored exactly.
+	bool encodeSourceLocation(string const& _value)
+	{
+		int64_t components[3];
+		size_t begin = 0;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			size_t end = (i == 2) ? _value.size() : _value.find(':', begin);
+			if (end == string::npos || !parseInteger(_value, begin, end, components[i]))
+				return false;
+			begin = end + 1;
+		}
+		appendTag(Tag::SourceLocation);
+		for (int64_t component: components)
+			appendUnsigned(m_body, zigzag(component));
+		return true;
+	}
+
+	/// Parses the decimal integer in @a _value between @a _begin and @a _end into @a _result.
+	/// @returns false unless the substring is exactly how to_string would print the number.
+	static bool parseInteger(string const& _value, size_t _begin, size_t _end, int64_t& _result)
+	{
+		bool negative = _begin < _end && _value[_begin] == '-';
+		if (negative)
+			++_begin;
+		// At most 18 digits to avoid overflows, no leading zeros and no "-0".
+		if (_begin == _end || _end - _begin > 18 || (_value[_begin] == '0' && (negative || _end - _begin > 1)))
+			return false;
+		_result = 0;
+		for (size_t i = _begin; i < _end; ++i)
+		{
+			if (_value[i] < '0' || _value[i] > '9')
+				return false;
+			_result = _result * 10 + (_value[i] - '0');
+		}
+		if (negative)
+			_result = -_result;
+		return true;
+	}
+
+	size_t intern(string const& _string)
+	{
+		auto inserted = m_stringIndices.emplace(_string, m_strings.size());
+		if (inserted.second)
+			m_strings.push_back(&inserted.first->first);
+		return inserted.first->second;
+	}
+
+	void appendTag(Tag _tag)
+	{
+		m_body.push_back(uint8_t(_tag));
+	}
+
+	static void appendUnsigned(bytes& _output, uint64_t _value)
+	{
+		while (_value >= 0x80)
+		{
+			_output.push_back(uint8_t(_value) | 0x80);
+			_value >>= 7;
+		}
+		_output.push_back(uint8_t(_value));
+	}
+
+	unordered_map<string, size_t> m_stringIndices;
+	vector<string const*> m_strings;
+	bytes m_body;
+};
+
+class Decoder
+{
+public:
+	explicit Decoder(bytes const& _data): m_data(_data) {}
+
+	Json::Value decode()
+	{
+		if (
+			m_data.size() < 5 ||
+			m_data[0] != 'S' || m_data[1] != 'A' || m_data[2] != 'S' || m_data[3] != 'T'
+		)
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid header."));
+		if (m_data[4] != ASTBinaryConverter::version)
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Unsupported version."));
+		m_pos = 5;
+
+		uint64_t stringCount = readUnsigned();
+		if (stringCount > m_data.size())
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid string table."));
+		m_strings.reserve(stringCount);
+		for (uint64_t i = 0; i < stringCount; ++i)
+		{
+			uint64_t length = readUnsigned();
+			if (length > m_data.size() - m_pos)
+				BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Unexpected end of data."));
+			m_strings.emplace_back(m_data.begin() + m_pos, m_data.begin() + m_pos + length);
+			m_pos += length;
+		}
+
+		Json::Value result = decodeValue();
+		if (m_pos != m_data.size())
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Trailing data."));
+		return result;
+	}
+
+private:
+	Json::Value decodeValue()
+	{
+		switch (Tag(readByte()))
+		{
+		case Tag::Null:
+			return Json::nullValue;
+		case Tag::False:
+			return false;
+		case Tag::True:
+			return true;
+		case Tag::Int:
+			return Json::Value(Json::Int64(unzigzag(readUnsigned())));
+		case Tag::UInt:
+			return Json::Value(Json::UInt64(readUnsigned()));
+		case Tag::Double:
+		{
+			uint64_t bits = 0;
+			for (size_t i = 0; i < 8; ++i)
+				bits |= uint64_t(readByte()) << (8 * i);
+			double value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+		case Tag::String:
+			return readString();
+		case Tag::Array:
+		{
+			Json::Value array(Json::arrayValue);
+			uint64_t size = readUnsigned();
+			if (size > m_data.size() - m_pos)
+				BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid array size."));
+			array.resize(Json::ArrayIndex(size));
+			for (Json::ArrayIndex i = 0; i < size; ++i)
+				array[i] = decodeValue();
+			return array;
+		}
+		case Tag::Object:
+		{
+			Json::Value object(Json::objectValue);
+			uint64_t size = readUnsigned();
+			for (uint64_t i = 0; i < size; ++i)
+			{
+				string const& name = readString();
+				object[name] = decodeValue();
+			}
+			return object;
+		}
+		case Tag::SourceLocation:
+		{
+			int64_t start = unzigzag(readUnsigned());
+			int64_t length = unzigzag(readUnsigned());
+			int64_t sourceIndex = unzigzag(readUnsigned());
+			return to_string(start) + ":" + to_string(length) + ":" + to_string(sourceIndex);
+		}
+		}
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid tag."));
+	}
+
+	string const& readString()
+	{
+		uint64_t index = readUnsigned();
+		if (index >= m_strings.size())
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid string index."));
+		return m_strings[index];
+	}
+
+	uint8_t readByte()
+	{
+		if (m_pos >= m_data.size())
+			BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Unexpected end of data."));
+		return m_data[m_pos++];
+	}
+
+	uint64_t readUnsigned()
+	{
+		uint64_t result = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			uint8_t byte = readByte();
+			result |= uint64_t(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return result;
+		}
+		BOOST_THROW_EXCEPTION(InvalidBinaryAST() << errinfo_comment("Invalid integer."));
+	}
+
+	bytes const& m_data;
+	size_t m_pos = 0;
+	vector<string> m_strings;
+};
+
+}
+
+ASTBinaryConverter::ASTBinaryConverter(map<string, unsigned> _sourceIndices):
+	m_sourceIndices(std::move(_sourceIndices))
+{
+}
+
+bytes ASTBinaryConverter::toBinary(ASTNode const& _node)
+{
+	return encode(ASTJsonConverter(false, m_sourceIndices).toJson(_node));
+}
+
+bytes ASTBinaryConverter::encode(Json::Value const& _json)
+{
+	return Encoder().encode(_json);
+}
+
+Json::Value ASTBinaryConverter::toJson(bytes const& _data)
+{
+	return Decoder(_data).decode();
+}
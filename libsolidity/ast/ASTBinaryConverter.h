@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Converts the AST into a compact binary format.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+
+#include <json/json.h>
+
+#include <map>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+DEV_SIMPLE_EXCEPTION(InvalidBinaryAST);
+
+/**
+ * Converter of the AST into a compact binary format.
+ *
+ * The encoded tree carries exactly the information of the compact JSON AST produced by
+ * ASTJsonConverter (node ids, source locations, type descriptions, ...), but is considerably
+ * smaller and faster to read, since all strings (member names included) are stored only once
+ * in a string table and source locations are stored as integers.
+ *
+ * Layout (all integers are unsigned LEB128, signed integers are zigzag-encoded first):
+ *   "SAST" <version byte> <number of strings> (<length> <bytes>)* <value>
+ * where a value is a one byte tag followed by its payload:
+ *   null, false, true: no payload
+ *   int: signed integer, uint: unsigned integer, double: 8 bytes little endian
+ *   string: index into the string table
+ *   array: <number of elements> <value>*
+ *   object: <number of members> (<string index of the member name> <value>)*
+ *   source location: <start> <length> <source index>, all signed
+ */
+class ASTBinaryConverter
+{
+public:
+	static uint8_t constexpr version = 1;
+
+	/// Create a converter for the given abstract syntax tree.
+	/// @a _sourceIndices is used to abbreviate source names in source locations.
+	explicit ASTBinaryConverter(std::map<std::string, unsigned> _sourceIndices = std::map<std::string, unsigned>());
+
+	/// @returns the binary representation of the AST rooted at @a _node.
+	bytes toBinary(ASTNode const& _node);
+
+	/// Encodes the JSON value @a _json (usually the compact JSON form of an AST).
+	static bytes encode(Json::Value const& _json);
+	/// Decodes the binary representation @a _data back into the compact JSON AST.
+	/// @throws InvalidBinaryAST if @a _data is malformed.
+	static Json::Value toJson(bytes const& _data);
+
+private:
+	std::map<std::string, unsigned> m_sourceIndices;
+};
+
+}
+}
@@ -168,6 +168,8 @@ Result<TypePointers> transformParametersToExternal(TypePointers const& _paramete
 void Type::clearCache() const
 {
 	m_members.clear();
+	m_richIdentifier.reset();
+	m_identifier.reset();
 }
 
 void StorageOffsets::computeOffsets(TypePointers const& _types)
@@ -299,15 +301,26 @@ string Type::escapeIdentifier(string const& _identifier)
 	return ret;
 }
 
-string Type::identifier() const
+string const& Type::richIdentifier() const
 {
-	string ret = escapeIdentifier(richIdentifier());
-	solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
-	solAssert(
-		ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
-		"Identifier contains invalid characters."
-	);
-	return ret;
+	if (!m_richIdentifier)
+		m_richIdentifier = makeRichIdentifier();
+	return *m_richIdentifier;
+}
+
+string const& Type::identifier() const
+{
+	if (!m_identifier)
+	{
+		string ret = escapeIdentifier(richIdentifier());
+		solAssert(ret.find_first_of("0123456789") != 0, "Identifier cannot start with a number.");
+		solAssert(
+			ret.find_first_not_of("0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMONPQRSTUVWXYZ_$") == string::npos,
+			"Identifier contains invalid characters."
+		);
+		m_identifier = std::move(ret);
+	}
+	return *m_identifier;
 }
 
 TypePointer Type::commonType(Type const* _a, Type const* _b)
@@ -393,7 +406,7 @@ AddressType::AddressType(StateMutability _stateMutability):
 	solAssert(m_stateMutability == StateMutability::Payable || m_stateMutability == StateMutability::NonPayable, "");
 }
 
-string AddressType::richIdentifier() const
+string AddressType::makeRichIdentifier() const
 {
 	if (m_stateMutability == StateMutability::Payable)
 		return "t_address_payable";
@@ -505,7 +518,7 @@ IntegerType::IntegerType(unsigned _bits, IntegerType::Modifier _modifier):
 	);
 }
 
-string IntegerType::richIdentifier() const
+string IntegerType::makeRichIdentifier() const
 {
 	return "t_" + string(isSigned() ? "" : "u") + "int" + to_string(numBits());
 }
@@ -631,7 +644,7 @@ FixedPointType::FixedPointType(unsigned _totalBits, unsigned _fractionalDigits,
 	);
 }
 
-string FixedPointType::richIdentifier() const
+string FixedPointType::makeRichIdentifier() const
 {
 	return "t_" + string(isSigned() ? "" : "u") + "fixed" + to_string(m_totalBits) + "x" + to_string(m_fractionalDigits);
 }
@@ -1126,7 +1139,7 @@ TypeResult RationalNumberType::binaryOperatorResult(Token _operator, Type const*
 	}
 }
 
-string RationalNumberType::richIdentifier() const
+string RationalNumberType::makeRichIdentifier() const
 {
 	// rational seemingly will put the sign always on the numerator,
 	// but let just make it deterministic here.
@@ -1281,7 +1294,7 @@ BoolResult StringLiteralType::isImplicitlyConvertibleTo(Type const& _convertTo)
 		return false;
 }
 
-string StringLiteralType::richIdentifier() const
+string StringLiteralType::makeRichIdentifier() const
 {
 	// Since we have to return a valid identifier and the string itself may contain
 	// anything, we hash it.
@@ -1376,7 +1389,7 @@ MemberList::MemberMap FixedBytesType::nativeMembers(ContractDefinition const*) c
 	return MemberList::MemberMap{MemberList::Member{"length", TypeProvider::uint(8)}};
 }
 
-string FixedBytesType::richIdentifier() const
+string FixedBytesType::makeRichIdentifier() const
 {
 	return "t_bytes" + to_string(m_bytes);
 }
@@ -1604,7 +1617,7 @@ BoolResult ArrayType::isExplicitlyConvertibleTo(Type const& _convertTo) const
 	return true;
 }
 
-string ArrayType::richIdentifier() const
+string ArrayType::makeRichIdentifier() const
 {
 	string id;
 	if (isString())
@@ -1864,7 +1877,7 @@ std::unique_ptr<ReferenceType> ArrayType::copyForLocation(DataLocation _location
 	return copy;
 }
 
-string ContractType::richIdentifier() const
+string ContractType::makeRichIdentifier() const
 {
 	return (m_super ? "t_super" : "t_contract") + parenthesizeUserIdentifier(m_contract.name()) + to_string(m_contract.id());
 }
@@ -1991,7 +2004,7 @@ BoolResult StructType::isImplicitlyConvertibleTo(Type const& _convertTo) const
 	return this->m_struct == convertTo.m_struct;
 }
 
-string StructType::richIdentifier() const
+string StructType::makeRichIdentifier() const
 {
 	return "t_struct" + parenthesizeUserIdentifier(m_struct.name()) + to_string(m_struct.id()) + identifierLocationSuffix();
 }
@@ -2290,7 +2303,7 @@ TypeResult EnumType::unaryOperatorResult(Token _operator) const
 	return _operator == Token::Delete ? TypeProvider::emptyTuple() : nullptr;
 }
 
-string EnumType::richIdentifier() const
+string EnumType::makeRichIdentifier() const
 {
 	return "t_enum" + parenthesizeUserIdentifier(m_enum.name()) + to_string(m_enum.id());
 }
@@ -2364,7 +2377,7 @@ BoolResult TupleType::isImplicitlyConvertibleTo(Type const& _other) const
 		return false;
 }
 
-string TupleType::richIdentifier() const
+string TupleType::makeRichIdentifier() const
 {
 	return "t_tuple" + identifierList(components());
 }
@@ -2655,7 +2668,7 @@ TypePointers FunctionType::parameterTypes() const
 	return TypePointers(m_parameterTypes.cbegin() + 1, m_parameterTypes.cend());
 }
 
-string FunctionType::richIdentifier() const
+string FunctionType::makeRichIdentifier() const
 {
 	string id = "t_function_";
 	switch (m_kind)
@@ -3257,7 +3270,7 @@ Type const* MappingType::encodingType() const
 	return TypeProvider::integer(256, IntegerType::Modifier::Unsigned);
 }
 
-string MappingType::richIdentifier() const
+string MappingType::makeRichIdentifier() const
 {
 	return "t_mapping" + identifierList(m_keyType, m_valueType);
 }
@@ -3300,7 +3313,7 @@ TypeResult MappingType::interfaceType(bool _inLibrary) const
 	return this;
 }
 
-string TypeType::richIdentifier() const
+string TypeType::makeRichIdentifier() const
 {
 	return "t_type" + identifierList(actualType());
 }
@@ -3385,7 +3398,7 @@ u256 ModifierType::storageSize() const
 	solAssert(false, "Storage size of non-storable type type requested.");
 }
 
-string ModifierType::richIdentifier() const
+string ModifierType::makeRichIdentifier() const
 {
 	return "t_modifier" + identifierList(m_parameterTypes);
 }
@@ -3418,7 +3431,7 @@ string ModifierType::toString(bool _short) const
 	return name + ")";
 }
 
-string ModuleType::richIdentifier() const
+string ModuleType::makeRichIdentifier() const
 {
 	return "t_module_" + to_string(m_sourceUnit.id());
 }
@@ -3444,7 +3457,7 @@ string ModuleType::toString(bool) const
 	return string("module \"") + m_sourceUnit.annotation().path + string("\"");
 }
 
-string MagicType::richIdentifier() const
+string MagicType::makeRichIdentifier() const
 {
 	switch (m_kind)
 	{
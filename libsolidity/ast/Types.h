@@ -175,12 +175,14 @@ public:
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Can contain characters which are invalid in identifiers.
-	virtual std::string richIdentifier() const = 0;
+	/// The identifier is only computed once per type object.
+	std::string const& richIdentifier() const;
 	/// @returns a valid solidity identifier such that two types should compare equal if and
 	/// only if they have the same identifier.
 	/// The identifier should start with "t_".
 	/// Will not contain any character which would be invalid as an identifier.
-	std::string identifier() const;
+	/// The identifier is only computed once per type object.
+	std::string const& identifier() const;
 
 	/// More complex identifier strings use "parentheses", where $_ is interpreted as
 	/// "opening parenthesis", _$ as "closing parenthesis", _$_ as "comma" and any $ that
@@ -332,6 +334,10 @@ private:
 	static MemberList::MemberMap boundFunctions(Type const& _type, ContractDefinition const& _scope);
 
 protected:
+	/// @returns the rich identifier of this type, see richIdentifier().
+	/// Is not called more than once per type object, since the result is cached.
+	virtual std::string makeRichIdentifier() const = 0;
+
 	/// @returns the members native to this type depending on the given context. This function
 	/// is used (in conjunction with boundFunctions to fill m_members below.
 	virtual MemberList::MemberMap nativeMembers(ContractDefinition const* /*_currentScope*/) const
@@ -341,6 +347,10 @@ protected:
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
 	mutable std::map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
+
+private:
+	mutable boost::optional<std::string> m_richIdentifier;
+	mutable boost::optional<std::string> m_identifier;
 };
 
 /**
@@ -353,7 +363,7 @@ public:
 
 	Category category() const override { return Category::Address; }
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -397,7 +407,7 @@ public:
 
 	Category category() const override { return Category::Integer; }
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -440,7 +450,7 @@ public:
 	explicit FixedPointType(unsigned _totalBits, unsigned _fractionalDigits, Modifier _modifier = Modifier::Unsigned);
 	Category category() const override { return Category::FixedPoint; }
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
@@ -498,7 +508,7 @@ public:
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 
 	bool canBeStored() const override { return false; }
@@ -559,7 +569,7 @@ public:
 		return nullptr;
 	}
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 
 	bool canBeStored() const override { return false; }
@@ -589,7 +599,7 @@ public:
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
@@ -617,7 +627,7 @@ class BoolType: public Type
 {
 public:
 	Category category() const override { return Category::Bool; }
-	std::string richIdentifier() const override { return "t_bool"; }
+	std::string makeRichIdentifier() const override { return "t_bool"; }
 	TypeResult unaryOperatorResult(Token _operator) const override;
 	TypeResult binaryOperatorResult(Token _operator, Type const* _other) const override;
 
@@ -719,7 +729,7 @@ public:
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
 	unsigned calldataEncodedTailSize() const override;
@@ -788,7 +798,7 @@ public:
 	/// Contracts can only be explicitly converted to address types and base contracts.
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool _padded ) const override
 	{
@@ -848,7 +858,7 @@ public:
 
 	Category category() const override { return Category::Struct; }
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool) const override;
 	unsigned calldataEncodedTailSize() const override;
@@ -913,7 +923,7 @@ public:
 
 	Category category() const override { return Category::Enum; }
 	TypeResult unaryOperatorResult(Token _operator) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	unsigned calldataEncodedSize(bool _padded) const override
 	{
@@ -954,7 +964,7 @@ public:
 	Category category() const override { return Category::Tuple; }
 
 	BoolResult isImplicitlyConvertibleTo(Type const& _other) const override;
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
 	std::string toString(bool) const override;
@@ -1108,7 +1118,7 @@ public:
 	/// @returns the "self" parameter type for a bound function
 	Type const* selfType() const;
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	BoolResult isImplicitlyConvertibleTo(Type const& _convertTo) const override;
 	BoolResult isExplicitlyConvertibleTo(Type const& _convertTo) const override;
@@ -1243,7 +1253,7 @@ public:
 
 	Category category() const override { return Category::Mapping; }
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	std::string toString(bool _short) const override;
 	std::string canonicalName() const override;
@@ -1277,7 +1287,7 @@ public:
 	Type const* actualType() const { return m_actualType; }
 
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	u256 storageSize() const override;
@@ -1308,7 +1318,7 @@ public:
 	bool canLiveOutsideStorage() const override { return false; }
 	unsigned sizeOnStack() const override { return 0; }
 	bool hasSimpleZeroValueInMemory() const override { solAssert(false, ""); }
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	std::string toString(bool _short) const override;
 
@@ -1329,7 +1339,7 @@ public:
 	Category category() const override { return Category::Module; }
 
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	bool canLiveOutsideStorage() const override { return true; }
@@ -1368,7 +1378,7 @@ public:
 		return nullptr;
 	}
 
-	std::string richIdentifier() const override;
+	std::string makeRichIdentifier() const override;
 	bool operator==(Type const& _other) const override;
 	bool canBeStored() const override { return false; }
 	bool canLiveOutsideStorage() const override { return true; }
@@ -1397,7 +1407,7 @@ class InaccessibleDynamicType: public Type
 public:
 	Category category() const override { return Category::InaccessibleDynamic; }
 
-	std::string richIdentifier() const override { return "t_inaccessible"; }
+	std::string makeRichIdentifier() const override { return "t_inaccessible"; }
 	BoolResult isImplicitlyConvertibleTo(Type const&) const override { return false; }
 	BoolResult isExplicitlyConvertibleTo(Type const&) const override { return false; }
 	TypeResult binaryOperatorResult(Token, Type const*) const override { return nullptr; }
@@ -72,6 +72,8 @@ public:
 	eth::AssemblyItems const& assemblyItems() const { return m_context.assembly().items(); }
 	/// @returns Assembly items of the runtime compiler context
 	eth::AssemblyItems const& runtimeAssemblyItems() const { return m_context.assembly().sub(m_runtimeSub).items(); }
+	/// @returns the jump tables of the runtime compiler context
+	eth::JumpTables const& runtimeJumpTables() const { return m_context.assembly().sub(m_runtimeSub).jumpTables(); }
 
 	/// @returns the entry label of the given function. Might return an AssemblyItem of type
 	/// UndefinedItem if it does not exist yet.
@@ -189,6 +189,9 @@ public:
 	void appendProgramSize() { m_asm->appendProgramSize(); }
 	/// Adds data to the data section, pushes a reference to the stack
 	eth::AssemblyItem appendData(bytes const& _data) { return m_asm->append(_data); }
+	/// Adds a jump table with the code offsets of the given tags to the data section,
+	/// pushes a reference to the stack.
+	eth::AssemblyItem appendJumpTable(std::vector<eth::AssemblyItem> const& _tags) { return m_asm->append(m_asm->newJumpTable(_tags)); }
 	/// Appends the address (virtual, will be filled in by linker) of a library.
 	void appendLibraryAddress(std::string const& _identifier) { m_asm->appendLibraryAddress(_identifier); }
 	/// Appends a zero-address that can be replaced by something else at deploy time (if the
@@ -264,11 +264,170 @@ void ContractCompiler::appendDelegatecallCheck()
 	// "We have not been called via DELEGATECALL".
 }
 
+namespace
+{
+
+/// @returns true if the binary search function selector should split the @a _functions
+/// functions, see ContractCompiler::appendInternalSelector for the cost model.
+bool splitSelector(size_t _functions, size_t _runs)
+{
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_functions <= 4)
+		return false;
+	else if (_runs > (17 * eth::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return (_runs * 6 * (_functions - 4) > 17 * eth::GasCosts::createDataGas);
+}
+
+/// @returns @a _ids ordered by descending number of calls according to @a _callCounts,
+/// so that frequently called functions are compared first. Keeps the order of functions
+/// with the same number of calls.
+vector<FixedHash<4>> orderedByCallCount(vector<FixedHash<4>> _ids, map<FixedHash<4>, size_t> const& _callCounts)
+{
+	auto callCount = [&](FixedHash<4> const& _id) -> size_t {
+		auto it = _callCounts.find(_id);
+		return it == _callCounts.end() ? 0 : it->second;
+	};
+	stable_sort(_ids.begin(), _ids.end(), [&](FixedHash<4> const& _a, FixedHash<4> const& _b) {
+		return callCount(_a) > callCount(_b);
+	});
+	return _ids;
+}
+
+/// Code size and the sum of the dispatch costs over all functions of a function selector.
+struct SelectorCost
+{
+	size_t bytes = 0;
+	size_t gas = 0;
+};
+
+// Each comparison "dup1 push4 <id> eq/gt push2 <tag> jumpi" takes 11 bytes and 22 gas,
+// the final "push2 <notfound> jump" takes 4 bytes.
+size_t const comparisonBytes = 11;
+size_t const comparisonGas = 22;
+size_t const notFoundJumpBytes = 4;
+
+SelectorCost binarySearchSelectorCost(size_t _functions, size_t _runs)
+{
+	SelectorCost cost;
+	if (splitSelector(_functions, _runs))
+	{
+		size_t smaller = _functions / 2;
+		SelectorCost largerCost = binarySearchSelectorCost(_functions - smaller, _runs);
+		SelectorCost smallerCost = binarySearchSelectorCost(smaller, _runs);
+		// Pivot comparison and the jumpdest of the smaller half.
+		cost.bytes = comparisonBytes + 1 + largerCost.bytes + smallerCost.bytes;
+		cost.gas = comparisonGas * _functions + smaller + largerCost.gas + smallerCost.gas;
+	}
+	else
+	{
+		cost.bytes = comparisonBytes * _functions + notFoundJumpBytes;
+		cost.gas = comparisonGas * _functions * (_functions + 1) / 2;
+	}
+	return cost;
+}
+
+/// Layout of a jump table function selector.
+struct JumpTableSelector
+{
+	unsigned shift = 0;
+	std::vector<std::vector<FixedHash<4>>> buckets;
+	SelectorCost cost;
+};
+
+/// @returns the cost of the lookup code of a jump table selector that uses @a _bits bits
+/// of the function identifier, starting at bit @a _shift.
+SelectorCost jumpTableLookupCost(unsigned _shift, unsigned _bits, bool _hasShifts)
+{
+	SelectorCost cost;
+	// push1 2, push <mask>, and, push <table>, add, push1 0x1e, codecopy,
+	// push1 0, mload, push2 0xffff, and, jump
+	cost.bytes = 2 + 1 + dev::bytesRequired(((size_t(1) << _bits) - 1) << 1) + 1 + 3 + 1 + 2 + 1 + 2 + 1 + 3 + 1 + 1;
+	cost.gas = 10 * 3 + 6 + 8;
+	if (_shift == 1)
+	{
+		// dup2
+		cost.bytes += 1;
+		cost.gas += 3;
+	}
+	else if (_hasShifts)
+	{
+		// dup2, push1 <shift - 1>, shr
+		cost.bytes += 4;
+		cost.gas += 9;
+	}
+	else
+	{
+		// push <2**(shift - 1)>, dup3, div
+		cost.bytes += 1 + dev::bytesRequired(size_t(1) << (_shift - 1)) + 2;
+		cost.gas += 11;
+	}
+	return cost;
+}
+
+/// @returns the cheapest jump table selector for the given sorted function identifiers.
+JumpTableSelector cheapestJumpTableSelector(vector<FixedHash<4>> const& _ids, size_t _runs, bool _hasShifts)
+{
+	unsigned minBits = 1;
+	while ((size_t(1) << minBits) < _ids.size())
+		minBits++;
+	minBits = max(minBits, 2u) - 1;
+
+	JumpTableSelector best;
+	u256 bestCost = 0;
+	for (unsigned bits = minBits; bits <= minBits + 2; ++bits)
+		for (unsigned shift = 1; shift + bits <= 32; ++shift)
+		{
+			JumpTableSelector candidate;
+			candidate.shift = shift;
+			candidate.buckets.resize(size_t(1) << bits);
+			for (auto const& id: _ids)
+			{
+				size_t index = (size_t(FixedHash<4>::Arith(id)) >> shift) & ((size_t(1) << bits) - 1);
+				candidate.buckets[index].push_back(id);
+			}
+			candidate.cost = jumpTableLookupCost(shift, bits, _hasShifts);
+			candidate.cost.bytes += candidate.buckets.size() * Assembly::jumpTableEntrySize;
+			candidate.cost.gas *= _ids.size();
+			for (auto const& bucket: candidate.buckets)
+				if (!bucket.empty())
+				{
+					// jumpdest, comparisons and jump to the "not found" tag
+					candidate.cost.bytes += 1 + comparisonBytes * bucket.size() + notFoundJumpBytes;
+					candidate.cost.gas += bucket.size() + comparisonGas * bucket.size() * (bucket.size() + 1) / 2;
+				}
+			u256 cost =
+				u256(_runs) * candidate.cost.gas +
+				u256(_ids.size()) * eth::GasCosts::createDataGas * candidate.cost.bytes;
+			if (best.buckets.empty() || cost < bestCost)
+			{
+				best = move(candidate);
+				bestCost = cost;
+			}
+		}
+	return best;
+}
+
+/// @returns true if the jump table selector is cheaper than the binary search selector
+/// for @a _functions functions, taking both deployment and execution costs into account.
+bool jumpTableSelectorIsCheaper(SelectorCost const& _jumpTable, size_t _functions, size_t _runs)
+{
+	SelectorCost binarySearch = binarySearchSelectorCost(_functions, _runs);
+	auto totalCost = [&](SelectorCost const& _cost) {
+		return u256(_runs) * _cost.gas + u256(_functions) * eth::GasCosts::createDataGas * _cost.bytes;
+	};
+	return totalCost(_jumpTable) < totalCost(binarySearch);
+}
+
+}
+
 void ContractCompiler::appendInternalSelector(
 	map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
 	vector<FixedHash<4>> const& _ids,
 	eth::AssemblyItem const& _notFoundTag,
-	size_t _runs
+	size_t _runs,
+	map<FixedHash<4>, size_t> const& _callCounts
 )
 {
 	// Code for selecting from n functions without split:
@@ -294,16 +453,7 @@ void ContractCompiler::appendInternalSelector(
 	// Which also means that the execution itself is not profitable
 	// unless we have at least 5 functions.
 
-	// Start with some comparisons to avoid overflow, then do the actual comparison.
-	bool split = false;
-	if (_ids.size() <= 4)
-		split = false;
-	else if (_runs > (17 * eth::GasCosts::createDataGas) / 6)
-		split = true;
-	else
-		split = (_runs * 6 * (_ids.size() - 4) > 17 * eth::GasCosts::createDataGas);
-
-	if (split)
+	if (splitSelector(_ids.size(), _runs))
 	{
 		size_t pivotIndex = _ids.size() / 2;
 		FixedHash<4> pivot{_ids.at(pivotIndex)};
@@ -311,15 +461,61 @@ void ContractCompiler::appendInternalSelector(
 		eth::AssemblyItem lessTag{m_context.appendConditionalJump()};
 		// Here, we have funid >= pivot
 		vector<FixedHash<4>> larger{_ids.begin() + pivotIndex, _ids.end()};
-		appendInternalSelector(_entryPoints, larger, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, larger, _notFoundTag, _runs, _callCounts);
 		m_context << lessTag;
 		// Here, we have funid < pivot
 		vector<FixedHash<4>> smaller{_ids.begin(), _ids.begin() + pivotIndex};
-		appendInternalSelector(_entryPoints, smaller, _notFoundTag, _runs);
+		appendInternalSelector(_entryPoints, smaller, _notFoundTag, _runs, _callCounts);
 	}
 	else
 	{
-		for (auto const& id: _ids)
+		for (auto const& id: orderedByCallCount(_ids, _callCounts))
+		{
+			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
+			m_context.appendConditionalJumpTo(_entryPoints.at(id));
+		}
+		m_context.appendJumpTo(_notFoundTag);
+	}
+}
+
+void ContractCompiler::appendJumpTableSelector(
+	map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
+	vector<vector<FixedHash<4>>> const& _buckets,
+	unsigned _shift,
+	eth::AssemblyItem const& _notFoundTag
+)
+{
+	// Code for selecting via a jump table with 2**k entries:
+	//   push1 2, <funid shifted right by shift - 1>, push <(2**k - 1) << 1>, and,
+	//   push <table>, add, push1 0x1e, codecopy, push1 0, mload, push2 0xffff, and, jump
+	// Each non-empty bucket selects from its functions like appendInternalSelector without split,
+	// the entries of empty buckets point to the "not found" tag.
+	// The table is copied to scratch space, which is not used by the function selector otherwise.
+	solAssert(_shift >= 1, "");
+	solAssert(_buckets.size() > 1 && (_buckets.size() & (_buckets.size() - 1)) == 0, "");
+	unsigned const entrySize = Assembly::jumpTableEntrySize;
+	m_context << u256(entrySize);
+	if (_shift == 1)
+		m_context << dupInstruction(2);
+	else if (m_context.evmVersion().hasBitwiseShifting())
+		m_context << dupInstruction(2) << u256(_shift - 1) << Instruction::SHR;
+	else
+		m_context << (u256(1) << (_shift - 1)) << dupInstruction(3) << Instruction::DIV;
+	m_context << (u256(_buckets.size() - 1) << 1) << Instruction::AND;
+	vector<eth::AssemblyItem> bucketTags;
+	for (auto const& bucket: _buckets)
+		bucketTags.emplace_back(bucket.empty() ? _notFoundTag : m_context.newTag());
+	m_context.appendJumpTable(bucketTags);
+	m_context << Instruction::ADD << u256(32 - entrySize) << Instruction::CODECOPY;
+	m_context << u256(0) << Instruction::MLOAD << u256((1 << (8 * entrySize)) - 1) << Instruction::AND;
+	m_context.appendJump(eth::AssemblyItem::JumpType::Ordinary);
+
+	for (size_t i = 0; i < _buckets.size(); ++i)
+	{
+		if (_buckets[i].empty())
+			continue;
+		m_context << bucketTags[i];
+		for (auto const& id: _buckets[i])
 		{
 			m_context << dupInstruction(1) << u256(FixedHash<4>::Arith(id)) << Instruction::EQ;
 			m_context.appendConditionalJumpTo(_entryPoints.at(id));
@@ -380,13 +576,26 @@ void ContractCompiler::appendFunctionSelector(ContractDefinition const& _contrac
 
 		// stack now is: <can-call-non-view-functions>? <funhash>
 		vector<FixedHash<4>> sortedIDs;
+		map<FixedHash<4>, size_t> callCounts;
 		for (auto const& it: interfaceFunctions)
 		{
 			callDataUnpackerEntryPoints.emplace(it.first, m_context.newTag());
 			sortedIDs.emplace_back(it.first);
+			auto count = m_optimiserSettings.functionCallCounts.find(it.second->externalSignature());
+			if (count != m_optimiserSettings.functionCallCounts.end())
+				callCounts[it.first] = count->second;
 		}
 		std::sort(sortedIDs.begin(), sortedIDs.end());
-		appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, m_optimiserSettings.expectedExecutionsPerDeployment);
+		size_t runs = m_optimiserSettings.expectedExecutionsPerDeployment;
+		JumpTableSelector jumpTable = cheapestJumpTableSelector(sortedIDs, runs, m_context.evmVersion().hasBitwiseShifting());
+		if (jumpTableSelectorIsCheaper(jumpTable.cost, sortedIDs.size(), runs))
+		{
+			for (auto& bucket: jumpTable.buckets)
+				bucket = orderedByCallCount(bucket, callCounts);
+			appendJumpTableSelector(callDataUnpackerEntryPoints, jumpTable.buckets, jumpTable.shift, notFound);
+		}
+		else
+			appendInternalSelector(callDataUnpackerEntryPoints, sortedIDs, notFound, runs, callCounts);
 	}
 
 	m_context << notFound;
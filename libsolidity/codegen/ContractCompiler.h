@@ -88,11 +88,23 @@ private:
 	void appendDelegatecallCheck();
 	/// Appends the function selector. Is called recursively to create a binary search tree.
 	/// @a _runs the number of intended executions of the contract to tune the split point.
+	/// @a _callCounts the number of calls of the functions from the execution profile, used to
+	/// order the comparisons.
 	void appendInternalSelector(
 		std::map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
 		std::vector<FixedHash<4>> const& _ids,
 		eth::AssemblyItem const& _notFoundTag,
-		size_t _runs
+		size_t _runs,
+		std::map<FixedHash<4>, size_t> const& _callCounts
+	);
+	/// Appends a function selector that takes the bits [_shift, _shift + log2(_buckets.size()))
+	/// of the function identifier as an index into a jump table. Each entry jumps to
+	/// code that compares the identifier against the functions in the respective bucket.
+	void appendJumpTableSelector(
+		std::map<FixedHash<4>, eth::AssemblyItem const> const& _entryPoints,
+		std::vector<std::vector<FixedHash<4>>> const& _buckets,
+		unsigned _shift,
+		eth::AssemblyItem const& _notFoundTag
 	);
 	void appendFunctionSelector(ContractDefinition const& _contract);
 	void appendCallValueCheck();
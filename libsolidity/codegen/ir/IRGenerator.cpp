@@ -32,6 +32,8 @@
 #include <libyul/AssemblyStack.h>
 #include <libyul/Utilities.h>
 
+#include <libevmasm/GasMeter.h>
+
 #include <libdevcore/CommonData.h>
 #include <libdevcore/Whiskers.h>
 #include <libdevcore/StringUtils.h>
@@ -252,8 +254,15 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 		if iszero(lt(calldatasize(), 4))
 		{
 			let selector := <shr224>(calldataload(0))
-			switch selector
-			<#cases>
+			<selectorSwitch>
+		}
+		<fallback>
+	)X");
+	t("shr224", m_utils.shiftRightFunction(224));
+	vector<pair<FixedHash<4>, string>> cases;
+	for (auto const& function: _contract.interfaceFunctions())
+	{
+		Whiskers templ(R"X(
 			case <functionSelector>
 			{
 				// <functionName>
@@ -264,44 +273,35 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 				let memEnd := <abiEncode>(memPos <comma> <retParams>)
 				return(memPos, sub(memEnd, memPos))
 			}
-			</cases>
-			default {}
-		}
-		<fallback>
-	)X");
-	t("shr224", m_utils.shiftRightFunction(224));
-	vector<map<string, string>> functions;
-	for (auto const& function: _contract.interfaceFunctions())
-	{
-		functions.push_back({});
-		map<string, string>& templ = functions.back();
-		templ["functionSelector"] = "0x" + function.first.hex();
+		)X");
+		templ("functionSelector", "0x" + function.first.hex());
 		FunctionTypePointer const& type = function.second;
-		templ["functionName"] = type->externalSignature();
-		templ["callValueCheck"] = type->isPayable() ? "" : callValueCheck();
+		templ("functionName", type->externalSignature());
+		templ("callValueCheck", type->isPayable() ? "" : callValueCheck());
 
 		unsigned paramVars = make_shared<TupleType>(type->parameterTypes())->sizeOnStack();
 		unsigned retVars = make_shared<TupleType>(type->returnParameterTypes())->sizeOnStack();
-		templ["assignToParams"] = paramVars == 0 ? "" : "let " + suffixedVariableNameList("param_", 0, paramVars) + " := ";
-		templ["assignToRetParams"] = retVars == 0 ? "" : "let " + suffixedVariableNameList("ret_", 0, retVars) + " := ";
+		templ("assignToParams", paramVars == 0 ? "" : "let " + suffixedVariableNameList("param_", 0, paramVars) + " := ");
+		templ("assignToRetParams", retVars == 0 ? "" : "let " + suffixedVariableNameList("ret_", 0, retVars) + " := ");
 
 		ABIFunctions abiFunctions(m_evmVersion, m_context.functionCollector());
-		templ["abiDecode"] = abiFunctions.tupleDecoder(type->parameterTypes());
-		templ["params"] = suffixedVariableNameList("param_", 0, paramVars);
-		templ["retParams"] = suffixedVariableNameList("ret_", retVars, 0);
+		templ("abiDecode", abiFunctions.tupleDecoder(type->parameterTypes()));
+		templ("params", suffixedVariableNameList("param_", 0, paramVars));
+		templ("retParams", suffixedVariableNameList("ret_", retVars, 0));
 
 		if (FunctionDefinition const* funDef = dynamic_cast<FunctionDefinition const*>(&type->declaration()))
-			templ["function"] = generateFunction(*funDef);
+			templ("function", generateFunction(*funDef));
 		else if (VariableDeclaration const* varDecl = dynamic_cast<VariableDeclaration const*>(&type->declaration()))
-			templ["function"] = generateGetter(*varDecl);
+			templ("function", generateGetter(*varDecl));
 		else
 			solAssert(false, "Unexpected declaration for function!");
 
-		templ["allocate"] = m_utils.allocationFunction();
-		templ["abiEncode"] = abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), false);
-		templ["comma"] = retVars == 0 ? "" : ", ";
+		templ("allocate", m_utils.allocationFunction());
+		templ("abiEncode", abiFunctions.tupleEncoder(type->returnParameterTypes(), type->returnParameterTypes(), false));
+		templ("comma", retVars == 0 ? "" : ", ");
+		cases.emplace_back(function.first, templ.render());
 	}
-	t("cases", functions);
+	t("selectorSwitch", selectorSwitch(cases));
 	if (FunctionDefinition const* fallback = _contract.fallbackFunction())
 	{
 		string fallbackCode;
@@ -316,6 +316,40 @@ string IRGenerator::dispatchRoutine(ContractDefinition const& _contract)
 	return t.render();
 }
 
+string IRGenerator::selectorSwitch(vector<pair<FixedHash<4>, string>> const& _cases)
+{
+	// Yul cannot express computed jumps, so instead of a jump table, we use a binary search
+	// tree of switch statements. This uses the same cost model as the legacy code generator:
+	// A split pays off if "runs * 6 * (n - 4) > 17 * createDataGas".
+	size_t runs = m_optimiserSettings.expectedExecutionsPerDeployment;
+	size_t n = _cases.size();
+	bool split =
+		n > 4 &&
+		(runs > (17 * eth::GasCosts::createDataGas) / 6 || runs * 6 * (n - 4) > 17 * eth::GasCosts::createDataGas);
+	if (!split)
+	{
+		string code = "switch selector\n";
+		for (auto const& c: _cases)
+			code += c.second;
+		return code + "\ndefault {}";
+	}
+
+	size_t pivotIndex = n / 2;
+	return Whiskers(R"X(
+		switch lt(selector, <pivot>)
+		case 0 {
+			<larger>
+		}
+		default {
+			<smaller>
+		}
+	)X")
+	("pivot", "0x" + _cases[pivotIndex].first.hex())
+	("larger", selectorSwitch({_cases.begin() + pivotIndex, _cases.end()}))
+	("smaller", selectorSwitch({_cases.begin(), _cases.begin() + pivotIndex}))
+	.render();
+}
+
 string IRGenerator::memoryInit()
 {
 	// This function should be called at the beginning of the EVM call frame
@@ -27,6 +27,7 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <libdevcore/FixedHash.h>
 #include <string>
 
 namespace dev
@@ -67,6 +68,9 @@ private:
 	std::string runtimeObjectName(ContractDefinition const& _contract);
 
 	std::string dispatchRoutine(ContractDefinition const& _contract);
+	/// @returns a binary search tree of switch statements over the variable "selector"
+	/// with the given (sorted) function selectors and case statements as leaves.
+	std::string selectorSwitch(std::vector<std::pair<FixedHash<4>, std::string>> const& _cases);
 
 	std::string memoryInit();
 
@@ -22,30 +22,102 @@
 
 #include <boost/algorithm/string/replace.hpp>
 
+#include <atomic>
+#include <cctype>
+#include <future>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-BMC::BMC(smt::EncodingContext& _context, ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
+namespace
+{
+
+string solverErrorDescription(smt::SolverError const& _error)
+{
+	string description("Error querying SMT solver");
+	if (_error.comment())
+		description += ": " + *_error.comment();
+	return description;
+}
+
+void formatValues(vector<string>& _values)
+{
+	for (string& value: _values)
+	{
+		try
+		{
+			// Parse and re-format nicely
+			value = formatNumberReadable(bigint(value));
+		}
+		catch (...) { }
+	}
+}
+
+/// Declares the variables and uninterpreted functions occurring in @a _expression.
+/// Subterms in @a _visited are skipped, since their symbols are declared already.
+void declareSymbols(
+	smt::SolverInterface& _solver,
+	smt::Expression const& _expression,
+	smt::ExpressionCache<bool>& _visited
+)
+{
+	if (_visited.find(_expression))
+		return;
+	_visited.insert(_expression, true);
+	for (auto const& argument: _expression.arguments())
+		declareSymbols(_solver, argument, _visited);
+
+	string const& name = _expression.name();
+	if (_expression.arguments().empty())
+	{
+		bool literal =
+			name.empty() ||
+			name == "true" ||
+			name == "false" ||
+			isdigit(static_cast<unsigned char>(name.front())) ||
+			name.front() == '-';
+		if (!literal)
+			_solver.declareVariable(name, *_expression.sort());
+	}
+	else if (!smt::Expression::isOperator(name))
+	{
+		vector<smt::SortPointer> domain;
+		for (auto const& argument: _expression.arguments())
+			domain.push_back(argument.sort());
+		_solver.declareVariable(name, smt::FunctionSort(move(domain), _expression.sort()));
+	}
+}
+
+}
+
+BMC::BMC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	ReadCallback::Callback const& _smtCallback,
+	shared_ptr<smt::SMTQueryCache> _queryCache,
+	smt::SolverLimits const& _solverLimits,
+	chrono::steady_clock::time_point _deadline,
+	bool _functionSummaries
+):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
-	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses))
+	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses, _smtCallback, _queryCache, _solverLimits)),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_queryCache(move(_queryCache)),
+	m_solverLimits(_solverLimits),
+	m_deadline(_deadline),
+	m_functionSummaries(_functionSummaries)
 {
-#if defined (HAVE_Z3) || defined (HAVE_CVC4)
-	if (!_smtlib2Responses.empty())
-		m_errorReporter.warning(
-			"SMT-LIB2 query responses were given in the auxiliary input, "
-			"but this Solidity binary uses an SMT solver (Z3/CVC4) directly."
-			"These responses will be ignored."
-			"Consider disabling Z3/CVC4 at compilation time in order to use SMT-LIB2 responses."
-		);
-#endif
 }
 
-void BMC::analyze(SourceUnit const& _source, set<Expression const*> _safeAssertions)
+void BMC::analyze(ContractDefinition const& _contract, set<Expression const*> _safeAssertions)
 {
-	solAssert(_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
+	solAssert(_contract.sourceUnit().annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
 
 	m_safeAssertions += move(_safeAssertions);
 	m_context.setSolver(m_interface);
@@ -53,29 +125,25 @@ void BMC::analyze(SourceUnit const& _source, set<Expression const*> _safeAsserti
 	m_context.setAssertionAccumulation(true);
 	m_variableUsage.setFunctionInlining(true);
 
-	_source.accept(*this);
+	_contract.accept(*this);
 
 	solAssert(m_interface->solvers() > 0, "");
 	// If this check is true, Z3 and CVC4 are not available
 	// and the query answers were not provided, since SMTPortfolio
 	// guarantees that SmtLib2Interface is the first solver.
 	if (!m_interface->unhandledQueries().empty() && m_interface->solvers() == 1)
-	{
-		if (!m_noSolverWarning)
-		{
-			m_noSolverWarning = true;
-			m_outerErrorReporter.warning(
-				SourceLocation(),
-				"BMC analysis was not possible since no integrated SMT solver (Z3 or CVC4) was found."
-			);
-		}
-	}
+		m_solverUnavailable = true;
 	else
 		m_outerErrorReporter.append(m_errorReporter.errors());
 
 	m_errorReporter.clear();
 }
 
+vector<string> BMC::unhandledQueries()
+{
+	return m_interface->unhandledQueries() + m_unhandledPoolQueries;
+}
+
 bool BMC::shouldInlineFunctionCall(FunctionCall const& _funCall)
 {
 	FunctionDefinition const* funDef = functionCallToDefinition(_funCall);
@@ -104,6 +172,35 @@ bool BMC::shouldInlineFunctionCall(FunctionCall const& _funCall)
 	return true;
 }
 
+bool BMC::shouldSummarizeFunctionCall(FunctionCall const& _funCall) const
+{
+	if (!m_functionSummaries || !shouldInlineFunctionCall(_funCall))
+		return false;
+
+	FunctionType const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
+	if (funType.kind() != FunctionType::Kind::Internal)
+		return false;
+
+	// Only calls to pure functions are deterministic in their arguments.
+	FunctionDefinition const* funDef = functionCallToDefinition(_funCall);
+	solAssert(funDef, "");
+	if (funDef->stateMutability() != StateMutability::Pure || !funDef->modifiers().empty())
+		return false;
+
+	// The summary is an uninterpreted function, so it needs arguments and
+	// cannot take or return reference or function types.
+	if (funDef->parameters().empty())
+		return false;
+	for (auto const& param: funDef->parameters() + funDef->returnParameters())
+	{
+		Type const& type = *param->type();
+		if (!type.isValueType() || !smt::isSupportedType(type) || smt::isFunction(type.category()))
+			return false;
+	}
+
+	return true;
+}
+
 /// AST visitors.
 
 bool BMC::visit(ContractDefinition const& _contract)
@@ -450,6 +547,53 @@ void BMC::inlineFunctionCall(FunctionCall const& _funCall)
 	createReturnedExpressions(_funCall);
 }
 
+void BMC::summarizeFunctionCall(FunctionCall const& _funCall)
+{
+	solAssert(shouldSummarizeFunctionCall(_funCall), "");
+	FunctionDefinition const* funDef = functionCallToDefinition(_funCall);
+	solAssert(funDef, "");
+
+	auto const& returnParams = funDef->returnParameters();
+	if (!m_summaries.count(funDef))
+	{
+		vector<smt::SortPointer> domain;
+		for (auto const& param: funDef->parameters())
+			domain.push_back(smt::smtSort(*param->type()));
+		auto& summary = m_summaries[funDef];
+		for (unsigned i = 0; i < returnParams.size(); ++i)
+			summary.push_back(make_shared<smt::SymbolicFunctionVariable>(
+				make_shared<smt::FunctionSort>(domain, smt::smtSort(*returnParams.at(i)->type())),
+				"summary_" + funDef->name() + "_" + to_string(funDef->id()) + "_" + to_string(i),
+				m_context
+			));
+	}
+
+	vector<smt::Expression> funArgs;
+	auto const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
+	if (funType.bound())
+	{
+		auto const& boundFunction = dynamic_cast<MemberAccess const*>(&_funCall.expression());
+		solAssert(boundFunction, "");
+		funArgs.push_back(expr(boundFunction->expression()));
+	}
+	for (auto arg: _funCall.arguments())
+		funArgs.push_back(expr(*arg));
+	solAssert(funArgs.size() == funDef->parameters().size(), "");
+
+	auto const& summary = m_summaries.at(funDef);
+	for (unsigned i = 0; i < returnParams.size(); ++i)
+	{
+		createVariable(*returnParams.at(i));
+		m_context.newValue(*returnParams.at(i));
+		m_context.setUnknownValue(*returnParams.at(i));
+		m_context.addAssertion(currentValue(*returnParams.at(i)) == (*summary.at(i))(funArgs));
+	}
+
+	createReturnedExpressions(_funCall);
+	if (returnParams.size() == 1)
+		m_uninterpretedTerms.insert(&_funCall);
+}
+
 void BMC::abstractFunctionCall(FunctionCall const& _funCall)
 {
 	vector<smt::Expression> smtArguments;
@@ -463,7 +607,9 @@ void BMC::abstractFunctionCall(FunctionCall const& _funCall)
 void BMC::internalOrExternalFunctionCall(FunctionCall const& _funCall)
 {
 	auto const& funType = dynamic_cast<FunctionType const&>(*_funCall.expression().annotation().type);
-	if (shouldInlineFunctionCall(_funCall))
+	if (shouldSummarizeFunctionCall(_funCall))
+		summarizeFunctionCall(_funCall);
+	else if (shouldInlineFunctionCall(_funCall))
 		inlineFunctionCall(_funCall);
 	else if (funType.kind() == FunctionType::Kind::Internal)
 		m_errorReporter.warning(
@@ -550,8 +696,27 @@ pair<vector<smt::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets(smt::Expression const& _constraints)
 {
+	// The queries of the targets are independent of each other. They are collected
+	// first and solved in parallel. The targets are then checked in order using the
+	// results, so that the warnings do not depend on the order in which the queries
+	// were solved.
+	// This is only done if an integrated solver or an SMT callback is available, since
+	// the queries of the solver pool differ from those of m_interface and SMT-LIB2
+	// responses given for the latter would not match, and if there is more than one
+	// hardware thread.
+	if ((m_interface->solvers() > 1 || m_smtCallback) && thread::hardware_concurrency() > 1)
+	{
+		m_collectingQueries = true;
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target, _constraints);
+		m_collectingQueries = false;
+		smt::EncodingContext::SolverScope solving(m_context);
+		solveCollectedQueries();
+	}
+
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target, _constraints);
+	solAssert(m_precomputedResults.empty(), "");
 }
 
 void BMC::checkVerificationTarget(VerificationTarget& _target, smt::Expression const& _constraints)
@@ -610,6 +775,7 @@ void BMC::checkUnderflow(VerificationTarget& _target, smt::Expression const& _co
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
+		"underflow",
 		"Underflow (resulting value less than " + formatNumberReadable(intType->minValue()) + ")",
 		"<result>",
 		&_target.value
@@ -630,6 +796,7 @@ void BMC::checkOverflow(VerificationTarget& _target, smt::Expression const& _con
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
+		"overflow",
 		"Overflow (resulting value larger than " + formatNumberReadable(intType->maxValue()) + ")",
 		"<result>",
 		&_target.value
@@ -644,6 +811,7 @@ void BMC::checkDivByZero(VerificationTarget& _target)
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
+		"division by zero",
 		"Division by zero",
 		"<result>",
 		&_target.value
@@ -658,6 +826,7 @@ void BMC::checkBalance(VerificationTarget& _target)
 		_target.callStack,
 		_target.modelExpressions,
 		_target.expression->location(),
+		"balance",
 		"Insufficient funds",
 		"address(this).balance"
 	);
@@ -672,6 +841,7 @@ void BMC::checkAssert(VerificationTarget& _target)
 			_target.callStack,
 			_target.modelExpressions,
 			_target.expression->location(),
+			"assertion",
 			"Assertion violation"
 		);
 }
@@ -703,14 +873,12 @@ void BMC::checkCondition(
 	vector<SMTEncoder::CallStackEntry> const& callStack,
 	pair<vector<smt::Expression>, vector<string>> const& _modelExpressions,
 	SourceLocation const& _location,
+	string const& _target,
 	string const& _description,
 	string const& _additionalValueName,
 	smt::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smt::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -722,7 +890,9 @@ void BMC::checkCondition(
 		}
 	smt::CheckResult result;
 	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	tie(result, values) = solve(_target, _location, _condition, expressionsToEvaluate);
+	if (m_collectingQueries)
+		return;
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -752,7 +922,7 @@ void BMC::checkCondition(
 			solAssert(values.size() == expressionNames.size(), "");
 			map<string, string> sortedModel;
 			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
+				if (expressionsToEvaluate.at(i).name() != values.at(i))
 					sortedModel[expressionNames.at(i)] = values.at(i);
 
 			for (auto const& eval: sortedModel)
@@ -784,8 +954,6 @@ void BMC::checkCondition(
 		m_errorReporter.warning(_location, "Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -800,15 +968,10 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	auto positiveResult = solve("constant condition", _condition.location(), _constraints && _value).first;
+	auto negatedResult = solve("constant condition", _condition.location(), _constraints && !_value).first;
+	if (m_collectingQueries)
+		return;
 
 	if (positiveResult == smt::CheckResult::ERROR || negatedResult == smt::CheckResult::ERROR)
 		m_errorReporter.warning(_condition.location(), "Error trying to invoke SMT solver.");
@@ -853,32 +1016,136 @@ BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expression
 	vector<string> values;
 	try
 	{
+		smt::EncodingContext::SolverScope solving(m_context);
 		tie(result, values) = m_interface->check(_expressionsToEvaluate);
 	}
 	catch (smt::SolverError const& _e)
 	{
-		string description("Error querying SMT solver");
-		if (_e.comment())
-			description += ": " + *_e.comment();
-		m_errorReporter.warning(description);
+		m_errorReporter.warning(solverErrorDescription(_e));
 		result = smt::CheckResult::ERROR;
 	}
 
-	for (string& value: values)
+	formatValues(values);
+
+	return make_pair(result, values);
+}
+
+pair<smt::CheckResult, vector<string>> BMC::solve(
+	string const& _target,
+	SourceLocation const& _location,
+	smt::Expression const& _condition,
+	vector<smt::Expression> const& _expressionsToEvaluate
+)
+{
+	if (m_collectingQueries)
 	{
-		try
-		{
-			// Parse and re-format nicely
-			value = formatNumberReadable(bigint(value));
-		}
-		catch (...) { }
+		m_collectedQueries.push_back({_condition, _expressionsToEvaluate});
+		return {smt::CheckResult::UNKNOWN, {}};
 	}
 
-	return make_pair(result, values);
+	if (!m_precomputedResults.empty())
+	{
+		QueryResult queryResult = move(m_precomputedResults.front());
+		m_precomputedResults.pop_front();
+		if (queryResult.error)
+			m_errorReporter.warning(*queryResult.error);
+		m_unhandledPoolQueries += move(queryResult.unhandledQueries);
+		m_deadlineExceeded = m_deadlineExceeded || queryResult.skipped;
+		m_queryTelemetry.push_back({
+			_target,
+			_location,
+			queryResult.result,
+			queryResult.duration,
+			move(queryResult.solvers)
+		});
+		formatValues(queryResult.values);
+		return {queryResult.result, move(queryResult.values)};
+	}
+
+	if (chrono::steady_clock::now() >= m_deadline)
+	{
+		m_deadlineExceeded = true;
+		m_queryTelemetry.push_back({_target, _location, smt::CheckResult::UNKNOWN, chrono::milliseconds(0), {}});
+		return {smt::CheckResult::UNKNOWN, {}};
+	}
+
+	auto start = chrono::steady_clock::now();
+	m_interface->push();
+	m_interface->addAssertion(_condition);
+	auto result = checkSatisfiableAndGenerateModel(_expressionsToEvaluate);
+	m_interface->pop();
+	m_queryTelemetry.push_back({
+		_target,
+		_location,
+		result.first,
+		chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start),
+		m_interface->lastRuns()
+	});
+	return result;
 }
 
-smt::CheckResult BMC::checkSatisfiable()
+void BMC::solveCollectedQueries()
 {
-	return checkSatisfiableAndGenerateModel({}).first;
+	// The queries are split into chunks of consecutive queries, which usually share
+	// most of their constraints. The queries of a chunk are solved incrementally on one
+	// solver: Each query is only asserted under a fresh assumption literal, so that the
+	// solver keeps what it learnt from the previous queries of the chunk.
+	// Since the chunks do not depend on the size of the pool, neither do the models.
+	size_t const chunkSize = 8;
+	size_t chunks = (m_collectedQueries.size() + chunkSize - 1) / chunkSize;
+	vector<QueryResult> results(m_collectedQueries.size());
+	atomic<size_t> nextChunk{0};
+	auto solveQueries = [&]() {
+		for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++)
+		{
+			smt::SMTPortfolio solver(m_smtlib2Responses, m_smtCallback, m_queryCache, m_solverLimits);
+			smt::ExpressionCache<bool> declared;
+			for (size_t i = chunk * chunkSize; i < min((chunk + 1) * chunkSize, m_collectedQueries.size()); ++i)
+			{
+				Query const& query = m_collectedQueries[i];
+				QueryResult& result = results[i];
+				auto start = chrono::steady_clock::now();
+				if (start >= m_deadline)
+				{
+					result.result = smt::CheckResult::UNKNOWN;
+					result.skipped = true;
+					continue;
+				}
+				declareSymbols(solver, query.condition, declared);
+				for (auto const& expression: query.expressionsToEvaluate)
+					declareSymbols(solver, expression, declared);
+				// '#' cannot occur in the names of the symbolic variables.
+				smt::Expression assumption = solver.newVariable("#query_" + to_string(i), make_shared<smt::Sort>(smt::Kind::Bool));
+				solver.addAssertion(smt::Expression::implies(assumption, query.condition));
+
+				size_t previouslyUnhandled = solver.unhandledQueries().size();
+				try
+				{
+					tie(result.result, result.values) = solver.checkAssuming({assumption}, query.expressionsToEvaluate);
+				}
+				catch (smt::SolverError const& _e)
+				{
+					result.result = smt::CheckResult::ERROR;
+					result.values.clear();
+					result.error = solverErrorDescription(_e);
+				}
+				result.duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+				result.solvers = solver.lastRuns();
+				vector<string> unhandled = solver.unhandledQueries();
+				result.unhandledQueries.assign(unhandled.begin() + previouslyUnhandled, unhandled.end());
+			}
+		}
+	};
+
+	size_t poolSize = min<size_t>(thread::hardware_concurrency(), chunks);
+	vector<future<void>> pool;
+	for (size_t i = 0; i < poolSize; ++i)
+		pool.emplace_back(async(launch::async, solveQueries));
+	// Rethrows exceptions of the solvers.
+	for (auto& solver: pool)
+		solver.get();
+
+	m_precomputedResults.assign(make_move_iterator(results.begin()), make_move_iterator(results.end()));
+	m_collectedQueries.clear();
 }
 
@@ -29,12 +29,18 @@
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
+#include <libsolidity/formal/SMTPortfolio.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libsolidity/formal/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <boost/optional.hpp>
+
+#include <deque>
 #include <set>
 #include <string>
 #include <vector>
@@ -53,14 +59,32 @@ namespace solidity
 class BMC: public SMTEncoder
 {
 public:
-	BMC(smt::EncodingContext& _context, langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	BMC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		ReadCallback::Callback const& _smtCallback = {},
+		std::shared_ptr<smt::SMTQueryCache> _queryCache = nullptr,
+		smt::SolverLimits const& _solverLimits = {},
+		std::chrono::steady_clock::time_point _deadline = std::chrono::steady_clock::time_point::max(),
+		bool _functionSummaries = false
+	);
 
-	void analyze(SourceUnit const& _sources, std::set<Expression const*> _safeAssertions);
+	/// Analyzes @a _contract, skipping the assertions in @a _safeAssertions.
+	void analyze(ContractDefinition const& _contract, std::set<Expression const*> _safeAssertions);
 
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
+
+	/// @returns the telemetry of all queries in the order of the verification targets.
+	std::vector<QueryTelemetry> const& queryTelemetry() const { return m_queryTelemetry; }
+	/// @returns true if queries were not sent to the solvers because the deadline passed.
+	bool deadlineExceeded() const { return m_deadlineExceeded; }
+	/// @returns true if the analysis was not possible because neither an integrated
+	/// SMT solver nor responses to the SMT-LIB2 queries were available.
+	bool solverUnavailable() const { return m_solverUnavailable; }
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	static bool shouldInlineFunctionCall(FunctionCall const& _funCall);
@@ -92,7 +116,14 @@ private:
 	void inlineFunctionCall(FunctionCall const& _funCall);
 	/// Creates an uninterpreted function call.
 	void abstractFunctionCall(FunctionCall const& _funCall);
-	/// Inlines if the function call is internal or external to `this`.
+	/// @returns true if _funCall should be abstracted by the summary of
+	/// the called function instead of being inlined.
+	bool shouldSummarizeFunctionCall(FunctionCall const& _funCall) const;
+	/// Defines the return values of _funCall as applications of the summary
+	/// of the called function to the arguments.
+	void summarizeFunctionCall(FunctionCall const& _funCall);
+	/// Summarizes the function call if enabled, otherwise inlines it if it is
+	/// internal or external to `this`.
 	/// Erases knowledge about state variables if external.
 	void internalOrExternalFunctionCall(FunctionCall const& _funCall);
 
@@ -123,6 +154,8 @@ private:
 		std::pair<std::vector<smt::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
+	/// Checks the verification targets in order. If an integrated solver is available,
+	/// the queries of all targets are solved in parallel first.
 	void checkVerificationTargets(smt::Expression const& _constraints);
 	void checkVerificationTarget(VerificationTarget& _target, smt::Expression const& _constraints = smt::Expression(true));
 	void checkConstantCondition(VerificationTarget& _target);
@@ -146,6 +179,7 @@ private:
 		std::vector<CallStackEntry> const& callStack,
 		std::pair<std::vector<smt::Expression>, std::vector<std::string>> const& _modelExpressions,
 		langutil::SourceLocation const& _location,
+		std::string const& _target,
 		std::string const& _description,
 		std::string const& _additionalValueName = "",
 		smt::Expression const* _additionalValue = nullptr
@@ -163,7 +197,37 @@ private:
 	std::pair<smt::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
 
-	smt::CheckResult checkSatisfiable();
+	/// Checks whether @a _condition is satisfiable and evaluates @a _expressionsToEvaluate
+	/// in the model. Takes the result from m_precomputedResults if available and only
+	/// records the query if m_collectingQueries is set.
+	/// @a _target and @a _location describe the query in the telemetry.
+	std::pair<smt::CheckResult, std::vector<std::string>> solve(
+		std::string const& _target,
+		langutil::SourceLocation const& _location,
+		smt::Expression const& _condition,
+		std::vector<smt::Expression> const& _expressionsToEvaluate = {}
+	);
+
+	struct Query
+	{
+		smt::Expression condition;
+		std::vector<smt::Expression> expressionsToEvaluate;
+	};
+	struct QueryResult
+	{
+		smt::CheckResult result = smt::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Description of the error if the solver failed.
+		boost::optional<std::string> error;
+		std::vector<std::string> unhandledQueries;
+		std::chrono::milliseconds duration{0};
+		std::vector<smt::SolverRun> solvers;
+		/// True if the query was not solved because the deadline passed.
+		bool skipped = false;
+	};
+	/// Solves m_collectedQueries using a pool of solvers running in parallel
+	/// and stores the results in m_precomputedResults.
+	void solveCollectedQueries();
 	//@}
 
 	/// Flags used for better warning messages.
@@ -178,7 +242,34 @@ private:
 	/// Assertions that are known to be safe.
 	std::set<Expression const*> m_safeAssertions;
 
-	std::shared_ptr<smt::SolverInterface> m_interface;
+	std::shared_ptr<smt::SMTPortfolio> m_interface;
+
+	/// Used to create the solvers of the pool in solveCollectedQueries.
+	std::map<h256, std::string> const& m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+	std::shared_ptr<smt::SMTQueryCache> m_queryCache;
+	smt::SolverLimits m_solverLimits;
+
+	/// Queries are not sent to the solvers after this point in time.
+	std::chrono::steady_clock::time_point m_deadline;
+	bool m_deadlineExceeded = false;
+	std::vector<QueryTelemetry> m_queryTelemetry;
+	bool m_solverUnavailable = false;
+
+	/// Whether internal calls to pure functions are summarized instead of inlined.
+	bool m_functionSummaries;
+	/// Summaries of the called pure functions, one uninterpreted function
+	/// from the parameters to each return parameter.
+	/// The verification targets of a summarized function are only checked
+	/// when the function itself is analyzed.
+	std::map<FunctionDefinition const*, std::vector<std::shared_ptr<smt::SymbolicFunctionVariable>>> m_summaries;
+
+	/// If true, solve() only records the queries and checks do not report anything.
+	bool m_collectingQueries = false;
+	std::vector<Query> m_collectedQueries;
+	std::deque<QueryResult> m_precomputedResults;
+	/// Queries of the solver pool that the SMT-LIB2 interface could not answer.
+	std::vector<std::string> m_unhandledPoolQueries;
 };
 
 }
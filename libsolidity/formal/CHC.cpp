@@ -30,18 +30,26 @@ using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-CHC::CHC(smt::EncodingContext& _context, ErrorReporter& _errorReporter):
+CHC::CHC(
+	smt::EncodingContext& _context,
+	ErrorReporter& _errorReporter,
+	smt::SolverLimits const& _solverLimits,
+	chrono::steady_clock::time_point _deadline
+):
 	SMTEncoder(_context),
 #ifdef HAVE_Z3
-	m_interface(make_shared<smt::Z3CHCInterface>()),
+	m_interface(make_shared<smt::Z3CHCInterface>(_solverLimits)),
 #endif
-	m_outerErrorReporter(_errorReporter)
+	m_outerErrorReporter(_errorReporter),
+	m_deadline(_deadline)
 {
+	// Only used by the Z3 interface.
+	(void)_solverLimits;
 }
 
-void CHC::analyze(SourceUnit const& _source)
+void CHC::analyze(ContractDefinition const& _contract)
 {
-	solAssert(_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
+	solAssert(_contract.sourceUnit().annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
 
 #ifdef HAVE_Z3
 	auto z3Interface = dynamic_pointer_cast<smt::Z3CHCInterface>(m_interface);
@@ -51,7 +59,9 @@ void CHC::analyze(SourceUnit const& _source)
 	m_context.setAssertionAccumulation(false);
 	m_variableUsage.setFunctionInlining(false);
 
-	_source.accept(*this);
+	_contract.accept(*this);
+#else
+	(void)_contract;
 #endif
 }
 
@@ -534,14 +544,27 @@ smt::Expression CHC::predicateBodyCurrent(ASTNode const* _node)
 smt::Expression CHC::predicateEntry(ASTNode const* _node)
 {
 	solAssert(!m_path.empty(), "");
-	return (*m_predicates.at(_node))(m_path.back().arguments);
+	return (*m_predicates.at(_node))(m_path.back().arguments());
 }
 
 bool CHC::query(smt::Expression const& _query, langutil::SourceLocation const& _location)
 {
+	auto start = chrono::steady_clock::now();
+	if (start >= m_deadline)
+	{
+		m_deadlineExceeded = true;
+		m_queryTelemetry.push_back({"assertion", _location, smt::CheckResult::UNKNOWN, chrono::milliseconds(0), {}});
+		return false;
+	}
+
 	smt::CheckResult result;
 	vector<string> values;
-	tie(result, values) = m_interface->query(_query);
+	{
+		smt::EncodingContext::SolverScope solving(m_context);
+		tie(result, values) = m_interface->query(_query);
+	}
+	auto duration = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+	m_queryTelemetry.push_back({"assertion", _location, result, duration, {{"z3-spacer", result, duration}}});
 	switch (result)
 	{
 	case smt::CheckResult::SATISFIABLE:
@@ -33,6 +33,7 @@
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/formal/CHCSolverInterface.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
 
 #include <set>
 
@@ -44,12 +45,22 @@ namespace solidity
 class CHC: public SMTEncoder
 {
 public:
-	CHC(smt::EncodingContext& _context, langutil::ErrorReporter& _errorReporter);
+	CHC(
+		smt::EncodingContext& _context,
+		langutil::ErrorReporter& _errorReporter,
+		smt::SolverLimits const& _solverLimits = {},
+		std::chrono::steady_clock::time_point _deadline = std::chrono::steady_clock::time_point::max()
+	);
 
-	void analyze(SourceUnit const& _sources);
+	void analyze(ContractDefinition const& _contract);
 
 	std::set<Expression const*> const& safeAssertions() const { return m_safeAssertions; }
 
+	/// @returns the telemetry of all queries.
+	std::vector<QueryTelemetry> const& queryTelemetry() const { return m_queryTelemetry; }
+	/// @returns true if queries were not sent to the solver because the deadline passed.
+	bool deadlineExceeded() const { return m_deadlineExceeded; }
+
 private:
 	/// Visitor functions.
 	//@{
@@ -186,6 +197,11 @@ private:
 
 	/// ErrorReporter that comes from CompilerStack.
 	langutil::ErrorReporter& m_outerErrorReporter;
+
+	/// Queries are not sent to the solver after this point in time.
+	std::chrono::steady_clock::time_point m_deadline;
+	bool m_deadlineExceeded = false;
+	std::vector<QueryTelemetry> m_queryTelemetry;
 };
 
 }
@@ -24,8 +24,9 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-CVC4Interface::CVC4Interface():
-	m_solver(&m_context)
+CVC4Interface::CVC4Interface(SolverLimits const& _limits):
+	m_solver(&m_context),
+	m_limits(_limits)
 {
 	reset();
 }
@@ -35,7 +36,10 @@ void CVC4Interface::reset()
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
-	m_solver.setTimeLimit(queryTimeout);
+	if (m_limits.timeout > 0)
+		m_solver.setTimeLimit(m_limits.timeout);
+	if (m_limits.resourceLimit > 0)
+		m_solver.setResourceLimit(m_limits.resourceLimit);
 }
 
 void CVC4Interface::push()
@@ -115,20 +119,36 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 }
 
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	ExpressionCache<CVC4::Expr> cache;
+	return toCVC4Expr(_expr, cache);
+}
+
+CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr, ExpressionCache<CVC4::Expr>& _cache)
+{
+	if (CVC4::Expr const* translation = _cache.find(_expr))
+		return *translation;
+
+	CVC4::Expr translation = translate(_expr, _cache);
+	_cache.insert(_expr, translation);
+	return translation;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr, ExpressionCache<CVC4::Expr>& _cache)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments().empty() && m_variables.count(_expr.name()))
+		return m_variables.at(_expr.name());
 
 	vector<CVC4::Expr> arguments;
-	for (auto const& arg: _expr.arguments)
-		arguments.push_back(toCVC4Expr(arg));
+	for (auto const& arg: _expr.arguments())
+		arguments.push_back(toCVC4Expr(arg, _cache));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
+		if (!arguments.empty() && m_variables.count(_expr.name()))
 			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
 		// Literal
 		else if (arguments.empty())
@@ -43,7 +43,7 @@ namespace smt
 class CVC4Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	CVC4Interface();
+	explicit CVC4Interface(SolverLimits const& _limits = {});
 
 	void reset() override;
 
@@ -55,14 +55,23 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void interrupt() override { m_solver.interrupt(); }
+
+	std::string name() const override { return "cvc4"; }
+
 private:
+	/// @returns the translation of @a _expr. Subterms that occur several times
+	/// in @a _expr are translated only once.
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	CVC4::Expr toCVC4Expr(Expression const& _expr, ExpressionCache<CVC4::Expr>& _cache);
+	CVC4::Expr translate(Expression const& _expr, ExpressionCache<CVC4::Expr>& _cache);
 	CVC4::Type cvc4Sort(smt::Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<smt::SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	SolverLimits m_limits;
 };
 
 }
@@ -20,6 +20,7 @@
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/formal/SymbolicVariables.h>
 
+#include <mutex>
 #include <unordered_map>
 #include <set>
 
@@ -149,6 +150,33 @@ public:
 		solAssert(m_solver, "");
 		return m_solver;
 	}
+
+	/// Sets the mutex that guards the AST and the types if several contracts are
+	/// analyzed concurrently. The thread using this context holds it, except while
+	/// the solvers run.
+	void setASTMutex(std::mutex* _mutex) { m_astMutex = _mutex; }
+
+	/// Releases the AST mutex during its lifetime, so that other threads can access
+	/// the AST while the solvers run. The AST must not be accessed in the meantime.
+	class SolverScope
+	{
+	public:
+		explicit SolverScope(EncodingContext const& _context): m_mutex(_context.m_astMutex)
+		{
+			if (m_mutex)
+				m_mutex->unlock();
+		}
+		~SolverScope()
+		{
+			if (m_mutex)
+				m_mutex->lock();
+		}
+		SolverScope(SolverScope const&) = delete;
+		SolverScope& operator=(SolverScope const&) = delete;
+
+	private:
+		std::mutex* m_mutex;
+	};
 	//@}
 
 private:
@@ -184,6 +212,8 @@ private:
 
 	/// Whether to conjoin assertions in the assertion stack.
 	bool m_accumulateAssertions = true;
+
+	std::mutex* m_astMutex = nullptr;
 	//@}
 };
 
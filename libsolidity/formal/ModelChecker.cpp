@@ -17,28 +17,179 @@
 
 #include <libsolidity/formal/ModelChecker.h>
 
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-ModelChecker::ModelChecker(ErrorReporter& _errorReporter, map<h256, string> const& _smtlib2Responses):
-	m_bmc(m_context, _errorReporter, _smtlib2Responses),
-	m_chc(m_context, _errorReporter),
-	m_context()
+namespace
+{
+
+chrono::steady_clock::time_point deadline(ModelCheckerSettings const& _settings)
+{
+	if (_settings.totalTimeout == 0)
+		return chrono::steady_clock::time_point::max();
+	return chrono::steady_clock::now() + chrono::milliseconds(_settings.totalTimeout);
+}
+
+}
+
+ModelChecker::ModelChecker(
+	ErrorReporter& _errorReporter,
+	map<h256, string> const& _smtlib2Responses,
+	ReadCallback::Callback const& _smtCallback,
+	shared_ptr<smt::SMTQueryCache> _queryCache,
+	ModelCheckerSettings const& _settings
+):
+	m_errorReporter(_errorReporter),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_smtCallback(_smtCallback),
+	m_queryCache(move(_queryCache)),
+	m_settings(_settings),
+	m_deadline(deadline(_settings))
 {
 }
 
-void ModelChecker::analyze(SourceUnit const& _source)
+ModelChecker::~ModelChecker()
 {
-	if (!_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
-		return;
+	// Tasks that have not been started yet are skipped.
+	m_nextTask = m_queue.size();
+	for (auto& worker: m_workers)
+		worker.wait();
+}
+
+void ModelChecker::analyze(vector<SourceUnit const*> const& _sources)
+{
+	start(_sources);
+	finish();
+}
 
-	m_chc.analyze(_source);
-	m_bmc.analyze(_source, m_chc.safeAssertions());
+void ModelChecker::start(vector<SourceUnit const*> const& _sources)
+{
+	solAssert(m_tasks.empty() && m_workers.empty(), "The analysis was already started.");
+
+	for (SourceUnit const* source: _sources)
+	{
+		if (!source->annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker))
+			continue;
+		m_tasks.emplace_back();
+		for (auto contract: source->nodes())
+			if (auto contractDefinition = dynamic_cast<ContractDefinition const*>(contract.get()))
+				m_tasks.back().push_back(Task{contractDefinition, {}, {}, {}, {}, {}, false, false});
+	}
+	for (auto& sourceTasks: m_tasks)
+		for (Task& task: sourceTasks)
+			m_queue.push_back(&task);
+
+	size_t threads = m_settings.threads > 0 ? m_settings.threads : thread::hardware_concurrency();
+	size_t workers = min(max<size_t>(threads, 1), m_queue.size());
+	for (size_t i = 0; i < workers; ++i)
+		m_workers.emplace_back(async(launch::async, [this]() {
+			for (size_t task = m_nextTask++; task < m_queue.size(); task = m_nextTask++)
+				run(*m_queue[task]);
+		}));
+}
+
+void ModelChecker::finish()
+{
+	// Rethrows exceptions of the engines.
+	for (auto& worker: m_workers)
+		worker.get();
+	m_workers.clear();
+
+	for (auto& sourceTasks: m_tasks)
+	{
+		if (sourceTasks.empty())
+			continue;
+
+		for (Task& task: sourceTasks)
+			m_errorReporter.append(task.chcErrors);
+
+#if defined (HAVE_Z3) || defined (HAVE_CVC4)
+		if (!m_smtlib2Responses.empty() && !m_smtlib2ResponsesWarningIssued)
+		{
+			m_smtlib2ResponsesWarningIssued = true;
+			m_errorReporter.warning(
+				"SMT-LIB2 query responses were given in the auxiliary input, "
+				"but this Solidity binary uses an SMT solver (Z3/CVC4) directly."
+				"These responses will be ignored."
+				"Consider disabling Z3/CVC4 at compilation time in order to use SMT-LIB2 responses."
+			);
+		}
+#endif
+
+		bool deadlineExceeded = false;
+		for (Task& task: sourceTasks)
+		{
+			if (!task.solverUnavailable)
+				m_errorReporter.append(task.bmcErrors);
+			else if (!m_solverUnavailableWarningIssued)
+			{
+				m_solverUnavailableWarningIssued = true;
+				m_errorReporter.warning(
+					SourceLocation(),
+					"BMC analysis was not possible since no integrated SMT solver (Z3 or CVC4) was found."
+				);
+			}
+			deadlineExceeded = deadlineExceeded || task.deadlineExceeded;
+			m_unhandledQueries += move(task.unhandledQueries);
+			m_chcTelemetry += move(task.chcTelemetry);
+			m_bmcTelemetry += move(task.bmcTelemetry);
+		}
+
+		if (deadlineExceeded && !m_deadlineWarningIssued)
+		{
+			m_deadlineWarningIssued = true;
+			m_errorReporter.warning(
+				"The total timeout of the SMTChecker was exceeded. "
+				"Some verification targets were not checked."
+			);
+		}
+	}
+	m_tasks.clear();
+	m_queue.clear();
+}
+
+void ModelChecker::run(Task& _task)
+{
+	smt::EncodingContext context;
+	ErrorReporter chcErrorReporter(_task.chcErrors);
+	ErrorReporter bmcErrorReporter(_task.bmcErrors);
+	CHC chc(context, chcErrorReporter, m_settings.solverLimits, m_deadline);
+	BMC bmc(
+		context,
+		bmcErrorReporter,
+		m_smtlib2Responses,
+		m_smtCallback,
+		m_queryCache,
+		m_settings.solverLimits,
+		m_deadline,
+		m_settings.functionSummaries
+	);
+
+	{
+		lock_guard<mutex> lock(m_astMutex);
+		context.setASTMutex(&m_astMutex);
+		chc.analyze(*_task.contract);
+		bmc.analyze(*_task.contract, chc.safeAssertions());
+		context.setASTMutex(nullptr);
+	}
+
+	_task.unhandledQueries = bmc.unhandledQueries();
+	_task.chcTelemetry = chc.queryTelemetry();
+	_task.bmcTelemetry = bmc.queryTelemetry();
+	_task.deadlineExceeded = chc.deadlineExceeded() || bmc.deadlineExceeded();
+	_task.solverUnavailable = bmc.solverUnavailable();
 }
 
 vector<string> ModelChecker::unhandledQueries()
 {
-	return m_bmc.unhandledQueries();
+	return m_unhandledQueries;
+}
+
+vector<QueryTelemetry> ModelChecker::queryTelemetry() const
+{
+	return m_chcTelemetry + m_bmcTelemetry;
 }
@@ -25,10 +25,15 @@
 #include <libsolidity/formal/BMC.h>
 #include <libsolidity/formal/CHC.h>
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
 
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <atomic>
+#include <future>
+#include <mutex>
+
 namespace langutil
 {
 class ErrorReporter;
@@ -40,27 +45,89 @@ namespace dev
 namespace solidity
 {
 
+/**
+ * Analyzes the contracts of source units with the SMTChecker pragma.
+ * Each contract is analyzed by its own engines with their own encoding context and
+ * solvers, so that independent contracts can be analyzed concurrently. The results
+ * are reported in the order of the sources and contracts.
+ */
 class ModelChecker
 {
 public:
-	ModelChecker(langutil::ErrorReporter& _errorReporter, std::map<h256, std::string> const& _smtlib2Responses);
+	/// @param _smtCallback if given, SMT-LIB2 queries without a response in @a _smtlib2Responses
+	/// are sent to this callback.
+	/// @param _queryCache if given, results of SMT queries are looked up in and added to this cache.
+	/// The total timeout of @a _settings starts with the construction.
+	ModelChecker(
+		langutil::ErrorReporter& _errorReporter,
+		std::map<h256, std::string> const& _smtlib2Responses,
+		ReadCallback::Callback const& _smtCallback = {},
+		std::shared_ptr<smt::SMTQueryCache> _queryCache = nullptr,
+		ModelCheckerSettings const& _settings = {}
+	);
+	/// Waits for the analysis without reporting its results.
+	~ModelChecker();
+
+	/// Analyzes @a _sources and reports the results.
+	void analyze(std::vector<SourceUnit const*> const& _sources);
+
+	/// Starts the analysis of @a _sources on other threads and returns immediately.
+	/// Until finish() returns, other threads may only access the AST and the types
+	/// while holding astMutex().
+	void start(std::vector<SourceUnit const*> const& _sources);
+	/// Waits for the analysis started by start() and reports its results.
+	void finish();
 
-	void analyze(SourceUnit const& _sources);
+	/// @returns the mutex that guards the AST and the types during the analysis.
+	std::mutex& astMutex() { return m_astMutex; }
 
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
 	std::vector<std::string> unhandledQueries();
 
+	/// @returns the telemetry of the queries of all engines.
+	std::vector<QueryTelemetry> queryTelemetry() const;
+
 private:
-	/// Bounded Model Checker engine.
-	BMC m_bmc;
+	/// Analysis of a single contract and its results.
+	struct Task
+	{
+		ContractDefinition const* contract;
+		langutil::ErrorList chcErrors;
+		langutil::ErrorList bmcErrors;
+		std::vector<std::string> unhandledQueries;
+		std::vector<QueryTelemetry> chcTelemetry;
+		std::vector<QueryTelemetry> bmcTelemetry;
+		bool deadlineExceeded = false;
+		bool solverUnavailable = false;
+	};
+
+	/// Runs CHC and BMC on the contract of @a _task.
+	void run(Task& _task);
+
+	langutil::ErrorReporter& m_errorReporter;
+	std::map<h256, std::string> const& m_smtlib2Responses;
+	ReadCallback::Callback m_smtCallback;
+	std::shared_ptr<smt::SMTQueryCache> m_queryCache;
+	ModelCheckerSettings m_settings;
+	/// Queries are not sent to the solvers after this point in time.
+	std::chrono::steady_clock::time_point m_deadline;
+
+	bool m_deadlineWarningIssued = false;
+	bool m_solverUnavailableWarningIssued = false;
+	bool m_smtlib2ResponsesWarningIssued = false;
 
-	/// Constrained Horn Clauses engine.
-	CHC m_chc;
+	/// Tasks grouped by source unit.
+	std::vector<std::vector<Task>> m_tasks;
+	std::vector<Task*> m_queue;
+	std::atomic<size_t> m_nextTask{0};
+	std::mutex m_astMutex;
+	std::vector<std::future<void>> m_workers;
 
-	/// Stores the context of the encoding.
-	smt::EncodingContext m_context;
+	std::vector<std::string> m_unhandledQueries;
+	std::vector<QueryTelemetry> m_chcTelemetry;
+	std::vector<QueryTelemetry> m_bmcTelemetry;
 };
 
 }
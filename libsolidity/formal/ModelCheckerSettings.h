@@ -0,0 +1,66 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Settings of the SMTChecker and telemetry of its queries.
+ */
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <liblangutil/SourceLocation.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+
+struct ModelCheckerSettings
+{
+	smt::SolverLimits solverLimits;
+	/// Maximum duration of the whole analysis in milliseconds, unlimited if zero.
+	/// Queries after that are not sent to the solvers any more.
+	unsigned totalTimeout = 0;
+	/// If true, BMC abstracts internal calls to pure functions by uninterpreted functions
+	/// of the arguments instead of inlining the called function at every call site.
+	bool functionSummaries = false;
+	/// Maximum number of contracts that are analyzed concurrently, the number of
+	/// hardware threads if zero.
+	unsigned threads = 0;
+	/// If true, code generation starts while the contracts are still being analyzed.
+	bool asynchronous = false;
+};
+
+/// Telemetry of a query of the SMTChecker.
+struct QueryTelemetry
+{
+	/// Kind of the verification target, e.g. "overflow" or "assertion".
+	std::string target;
+	langutil::SourceLocation location;
+	smt::CheckResult result;
+	std::chrono::milliseconds duration;
+	/// Result and duration of each solver. Empty if the query was not sent to the
+	/// solvers because the total timeout was exceeded.
+	std::vector<smt::SolverRun> solvers;
+};
+
+}
+}
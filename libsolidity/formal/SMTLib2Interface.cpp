@@ -19,9 +19,7 @@
 
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/Exceptions.h>
-#include <libdevcore/Keccak256.h>
 
-#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem/operations.hpp>
 
@@ -37,8 +35,12 @@ using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTLib2Interface::SMTLib2Interface(map<h256, string> const& _queryResponses):
-	m_queryResponses(_queryResponses)
+SMTLib2Interface::SMTLib2Interface(
+	map<h256, string> const& _queryResponses,
+	ReadCallback::Callback _smtCallback
+):
+	m_queryResponses(_queryResponses),
+	m_smtCallback(move(_smtCallback))
 {
 	reset();
 }
@@ -54,7 +56,12 @@ void SMTLib2Interface::reset()
 
 void SMTLib2Interface::push()
 {
-	m_accumulatedOutput.emplace_back();
+	solAssert(!m_accumulatedOutput.empty(), "");
+	OutputLevel level;
+	level.totalSize = m_accumulatedOutput.back().totalSize + 1;
+	level.hash = m_accumulatedOutput.back().hash;
+	level.hash.update("\n");
+	m_accumulatedOutput.emplace_back(move(level));
 }
 
 void SMTLib2Interface::pop()
@@ -103,10 +110,7 @@ void SMTLib2Interface::addAssertion(Expression const& _expr)
 
 pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> const& _expressionsToEvaluate)
 {
-	string response = querySolver(
-		boost::algorithm::join(m_accumulatedOutput, "\n") +
-		checkSatAndGetValuesCommand(_expressionsToEvaluate)
-	);
+	string response = querySolver(querySuffix(_expressionsToEvaluate));
 
 	CheckResult result;
 	// TODO proper parsing
@@ -127,10 +131,10 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<Expression> con
 
 string SMTLib2Interface::toSExpr(Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
-	std::string sexpr = "(" + _expr.name;
-	for (auto const& arg: _expr.arguments)
+	if (_expr.arguments().empty())
+		return _expr.name();
+	std::string sexpr = "(" + _expr.name();
+	for (auto const& arg: _expr.arguments())
 		sexpr += " " + toSExpr(arg);
 	sexpr += ")";
 	return sexpr;
@@ -166,7 +170,29 @@ string SMTLib2Interface::toSmtLibSort(vector<SortPointer> const& _sorts)
 void SMTLib2Interface::write(string _data)
 {
 	solAssert(!m_accumulatedOutput.empty(), "");
-	m_accumulatedOutput.back() += move(_data) + "\n";
+	OutputLevel& level = m_accumulatedOutput.back();
+	_data += "\n";
+	level.totalSize += _data.size();
+	level.hash.update(_data);
+	level.commands.emplace_back(move(_data));
+}
+
+string SMTLib2Interface::query(vector<Expression> const& _expressionsToEvaluate, vector<Expression> const& _assumptions)
+{
+	return accumulatedOutput(querySuffix(_expressionsToEvaluate, _assumptions));
+}
+
+string SMTLib2Interface::querySuffix(vector<Expression> const& _expressionsToEvaluate, vector<Expression> const& _assumptions)
+{
+	string suffix;
+	// Same as the output of push() followed by addAssertion() for each assumption.
+	if (!_assumptions.empty())
+	{
+		suffix += "\n";
+		for (auto const& assumption: _assumptions)
+			suffix += "(assert " + toSExpr(assumption) + ")\n";
+	}
+	return suffix + checkSatAndGetValuesCommand(_expressionsToEvaluate);
 }
 
 string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _expressionsToEvaluate)
@@ -180,8 +206,8 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<Expression> const& _
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			solAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+			solAssert(e.sort()->kind == Kind::Int || e.sort()->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort()->kind == Kind::Int ? "Int" : "Bool") + ")\n";
 			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
 		command += "(check-sat)\n";
@@ -210,14 +236,38 @@ vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, stri
 	return values;
 }
 
-string SMTLib2Interface::querySolver(string const& _input)
+string SMTLib2Interface::accumulatedOutput(string const& _suffix) const
 {
-	h256 inputHash = dev::keccak256(_input);
-	if (m_queryResponses.count(inputHash))
-		return m_queryResponses.at(inputHash);
-	else
+	solAssert(!m_accumulatedOutput.empty(), "");
+	string output;
+	output.reserve(m_accumulatedOutput.back().totalSize + _suffix.size());
+	for (auto const& level: m_accumulatedOutput)
+	{
+		if (&level != &m_accumulatedOutput.front())
+			output += '\n';
+		for (auto const& command: level.commands)
+			output += command;
+	}
+	output += _suffix;
+	return output;
+}
+
+string SMTLib2Interface::querySolver(string const& _suffix)
+{
+	solAssert(!m_accumulatedOutput.empty(), "");
+	Keccak256Hasher hash = m_accumulatedOutput.back().hash;
+	hash.update(_suffix);
+	auto response = m_queryResponses.find(hash.digest());
+	if (response != m_queryResponses.end())
+		return response->second;
+	// The query text is only needed from here on.
+	string input = accumulatedOutput(_suffix);
+	if (m_smtCallback)
 	{
-		m_unhandledQueries.push_back(_input);
-		return "unknown\n";
+		ReadCallback::Result result = m_smtCallback(input);
+		if (result.success)
+			return result.responseOrErrorMessage;
 	}
+	m_unhandledQueries.push_back(move(input));
+	return "unknown\n";
 }
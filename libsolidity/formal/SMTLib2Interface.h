@@ -23,6 +23,7 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/FixedHash.h>
+#include <libdevcore/Keccak256.h>
 
 #include <boost/noncopyable.hpp>
 #include <cstdio>
@@ -41,7 +42,12 @@ namespace smt
 class SMTLib2Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	explicit SMTLib2Interface(std::map<h256, std::string> const& _queryResponses);
+	/// @param _smtCallback if given, queries without a response in @a _queryResponses are
+	/// sent to this callback.
+	explicit SMTLib2Interface(
+		std::map<h256, std::string> const& _queryResponses,
+		ReadCallback::Callback _smtCallback = {}
+	);
 
 	void reset() override;
 
@@ -55,6 +61,15 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	std::string name() const override { return "smtlib2"; }
+
+	/// @returns the input that checkAssuming() sends to the solver for @a _expressionsToEvaluate
+	/// and @a _assumptions.
+	std::string query(
+		std::vector<Expression> const& _expressionsToEvaluate,
+		std::vector<Expression> const& _assumptions = {}
+	);
+
 private:
 	void declareFunction(std::string const&, Sort const&);
 
@@ -64,16 +79,40 @@ private:
 
 	void write(std::string _data);
 
+	/// @returns the part of the query for @a _expressionsToEvaluate and @a _assumptions
+	/// that follows the accumulated output.
+	std::string querySuffix(
+		std::vector<Expression> const& _expressionsToEvaluate,
+		std::vector<Expression> const& _assumptions = {}
+	);
 	std::string checkSatAndGetValuesCommand(std::vector<Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
-	/// Communicates with the solver via the callback. Throws SMTSolverError on error.
-	std::string querySolver(std::string const& _input);
-
-	std::vector<std::string> m_accumulatedOutput;
+	/// @returns the accumulated output of all push levels followed by @a _suffix.
+	std::string accumulatedOutput(std::string const& _suffix) const;
+
+	/// Looks up the query consisting of the accumulated output and @a _suffix in the
+	/// query responses, and communicates with the solver via the callback otherwise.
+	/// Throws SMTSolverError on error.
+	std::string querySolver(std::string const& _suffix);
+
+	/// Output written at one push level. The output of all levels, separated by newlines,
+	/// forms the beginning of every query.
+	struct OutputLevel
+	{
+		/// Commands written at this level, each terminated by a newline.
+		std::vector<std::string> commands;
+		/// Size of the output of this and all previous levels.
+		size_t totalSize = 0;
+		/// Hash of the output of this and all previous levels, so that the hash of a
+		/// query only requires hashing the part of the query that follows it.
+		Keccak256Hasher hash;
+	};
+	std::vector<OutputLevel> m_accumulatedOutput;
 	std::set<std::string> m_variables;
 
 	std::map<h256, std::string> const& m_queryResponses;
+	ReadCallback::Callback m_smtCallback;
 	std::vector<std::string> m_unhandledQueries;
 };
 
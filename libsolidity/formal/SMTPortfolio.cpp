@@ -25,19 +25,33 @@
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
 
+#include <libdevcore/Common.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTPortfolio::SMTPortfolio(map<h256, string> const& _smtlib2Responses)
+SMTPortfolio::SMTPortfolio(
+	map<h256, string> const& _smtlib2Responses,
+	ReadCallback::Callback const& _smtCallback,
+	shared_ptr<SMTQueryCache> _queryCache,
+	SolverLimits const& _limits,
+	Policy _policy
+):
+	m_queryCache(move(_queryCache)),
+	m_policy(_policy)
 {
-	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses));
+	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses, _smtCallback));
 #ifdef HAVE_Z3
-	m_solvers.emplace_back(make_unique<smt::Z3Interface>());
+	m_solvers.emplace_back(make_unique<smt::Z3Interface>(_limits));
 #endif
 #ifdef HAVE_CVC4
-	m_solvers.emplace_back(make_unique<smt::CVC4Interface>());
+	m_solvers.emplace_back(make_unique<smt::CVC4Interface>(_limits));
 #endif
 }
 
@@ -100,16 +114,110 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *   when it is told that this is a hard query to solve.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * The solvers run concurrently, each on its own thread. With the FirstAnswer policy,
+ * the remaining solvers are interrupted as soon as one solver answers the query.
+ * Interrupted solvers return UNKNOWN, which by 1) does not change the result.
+ * The results are combined in the order of the solvers and not in the order in which
+ * they finished, so that the reported values do not depend on timing.
+ *
+ * Results found in the query cache are returned without querying any solver, and
+ * answers are added to the cache.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	m_lastRuns.clear();
+	auto elapsedSince = [](chrono::steady_clock::time_point _start) {
+		return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - _start);
+	};
+
+	string query;
+	if (m_queryCache)
+	{
+		auto start = chrono::steady_clock::now();
+		query = smtlib2Interface().query(_expressionsToEvaluate, _assumptions);
+		if (auto cachedResult = m_queryCache->lookup(query))
+		{
+			m_lastRuns.push_back({"cache", cachedResult->first, elapsedSince(start)});
+			return *cachedResult;
+		}
+	}
+
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	vector<chrono::milliseconds> durations(m_solvers.size(), chrono::milliseconds(0));
+	auto runSolver = [&](size_t _solver) {
+		auto start = chrono::steady_clock::now();
+		ScopeGuard measureDuration([&, _solver, start]() { durations[_solver] = elapsedSince(start); });
+		results[_solver] = m_solvers[_solver]->checkAssuming(_assumptions, _expressionsToEvaluate);
+	};
+	if (m_solvers.size() == 1)
+		runSolver(0);
+	else
+	{
+		mutex finishedMutex;
+		condition_variable solverFinished;
+		vector<bool> finished(m_solvers.size(), false);
+		vector<future<void>> runs;
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+			runs.emplace_back(async(launch::async, [&, i]() {
+				// Also signal completion if the solver throws.
+				ScopeGuard signalCompletion([&, i]() {
+					lock_guard<mutex> lock(finishedMutex);
+					finished[i] = true;
+					solverFinished.notify_all();
+				});
+				runSolver(i);
+			}));
+
+		{
+			unique_lock<mutex> lock(finishedMutex);
+			vector<bool> handled(m_solvers.size(), false);
+			auto unhandledSolver = [&]() {
+				for (size_t i = 0; i < m_solvers.size(); ++i)
+					if (finished[i] && !handled[i])
+						return true;
+				return false;
+			};
+			bool interrupted = false;
+			for (size_t handledCount = 0; handledCount < m_solvers.size();)
+			{
+				solverFinished.wait(lock, unhandledSolver);
+				for (size_t i = 0; i < m_solvers.size(); ++i)
+					if (finished[i] && !handled[i])
+					{
+						handled[i] = true;
+						++handledCount;
+						if (m_policy == Policy::FirstAnswer && !interrupted && solverAnswered(results[i].first))
+						{
+							interrupted = true;
+							for (size_t j = 0; j < m_solvers.size(); ++j)
+								if (!finished[j])
+									m_solvers[j]->interrupt();
+						}
+					}
+			}
+		}
+		// Rethrows exceptions of the solvers.
+		for (auto& run: runs)
+			run.get();
+	}
+	for (size_t i = 0; i < m_solvers.size(); ++i)
+		m_lastRuns.push_back({m_solvers[i]->name(), results[i].first, durations[i]});
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& solverResult: results)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		CheckResult result = solverResult.first;
+		vector<string>& values = solverResult.second;
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -126,16 +234,24 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
 			lastResult = result;
 	}
+	if (m_queryCache)
+		m_queryCache->store(query, {lastResult, finalValues});
 	return make_pair(lastResult, finalValues);
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
+{
+	return smtlib2Interface().unhandledQueries();
+}
+
+SMTLib2Interface& SMTPortfolio::smtlib2Interface()
 {
 	// This code assumes that the constructor guarantees that
 	// SmtLib2Interface is in position 0.
 	solAssert(!m_solvers.empty(), "");
-	solAssert(dynamic_cast<smt::SMTLib2Interface*>(m_solvers.front().get()), "");
-	return m_solvers.front()->unhandledQueries();
+	auto smtlib2 = dynamic_cast<smt::SMTLib2Interface*>(m_solvers.front().get());
+	solAssert(smtlib2, "");
+	return *smtlib2;
 }
 
 bool SMTPortfolio::solverAnswered(CheckResult result)
@@ -18,6 +18,7 @@
 #pragma once
 
 
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libdevcore/FixedHash.h>
@@ -33,16 +34,37 @@ namespace solidity
 namespace smt
 {
 
+class SMTLib2Interface;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Queries are sent to all solvers concurrently.
+ * If a query cache is given, it is consulted before any solver is queried.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
-	SMTPortfolio(std::map<h256, std::string> const& _smtlib2Responses);
+	/// Decides when check() stops waiting for the solvers.
+	enum class Policy
+	{
+		/// As soon as one solver answers (SAT or UNSAT), the other solvers are
+		/// interrupted. Conflicts are only detected if the other solvers answer
+		/// before they notice the interruption.
+		FirstAnswer,
+		/// Wait for all solvers to finish, which detects all conflicting answers.
+		WaitForAll
+	};
+
+	explicit SMTPortfolio(
+		std::map<h256, std::string> const& _smtlib2Responses,
+		ReadCallback::Callback const& _smtCallback = {},
+		std::shared_ptr<SMTQueryCache> _queryCache = nullptr,
+		SolverLimits const& _limits = {},
+		Policy _policy = Policy::FirstAnswer
+	);
 
 	void reset() override;
 
@@ -54,13 +76,29 @@ public:
 	void addAssertion(Expression const& _expr) override;
 
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+
+	std::string name() const override { return "portfolio"; }
+
+	/// @returns the result and duration of each solver in the last check, or a single
+	/// run of the solver "cache" if the result was found in the query cache.
+	std::vector<SolverRun> const& lastRuns() const { return m_lastRuns; }
+
 private:
 	static bool solverAnswered(CheckResult result);
 
+	SMTLib2Interface& smtlib2Interface();
+
 	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	std::shared_ptr<SMTQueryCache> m_queryCache;
+	Policy m_policy;
+	std::vector<SolverRun> m_lastRuns;
 
 	std::vector<Expression> m_assertions;
 };
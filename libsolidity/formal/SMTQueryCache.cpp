@@ -0,0 +1,139 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+bool isAnswer(CheckResult _result)
+{
+	return _result == CheckResult::SATISFIABLE || _result == CheckResult::UNSATISFIABLE;
+}
+
+}
+
+SMTQueryCache::SMTQueryCache(boost::filesystem::path _directory):
+	m_directory(move(_directory))
+{
+}
+
+boost::optional<SMTQueryCache::Result> SMTQueryCache::lookup(string const& _query)
+{
+	h256 hash = keccak256(normalise(_query));
+	lock_guard<mutex> lock(m_mutex);
+	auto it = m_results.find(hash);
+	if (it == m_results.end() && !m_directory.empty())
+		if (auto result = readFromDirectory(hash))
+			it = m_results.emplace(hash, move(*result)).first;
+
+	if (it == m_results.end())
+	{
+		++m_misses;
+		return {};
+	}
+	++m_hits;
+	return it->second;
+}
+
+void SMTQueryCache::store(string const& _query, Result const& _result)
+{
+	if (!isAnswer(_result.first))
+		return;
+	h256 hash = keccak256(normalise(_query));
+	lock_guard<mutex> lock(m_mutex);
+	m_results[hash] = _result;
+	if (!m_directory.empty())
+		writeToDirectory(hash, _result);
+}
+
+string SMTQueryCache::normalise(string const& _query)
+{
+	map<string, string> names;
+	string normalised;
+	normalised.reserve(_query.size());
+	for (size_t pos = 0; pos < _query.size();)
+	{
+		size_t start = _query.find('|', pos);
+		size_t end = start == string::npos ? string::npos : _query.find('|', start + 1);
+		if (end == string::npos)
+		{
+			normalised += _query.substr(pos);
+			break;
+		}
+		normalised += _query.substr(pos, start - pos);
+		string name = _query.substr(start + 1, end - start - 1);
+		if (!names.count(name))
+			names[name] = "v" + to_string(names.size());
+		normalised += "|" + names[name] + "|";
+		pos = end + 1;
+	}
+	return normalised;
+}
+
+boost::optional<SMTQueryCache::Result> SMTQueryCache::readFromDirectory(h256 const& _hash) const
+{
+	vector<string> lines;
+	string content = readFileAsString((m_directory / _hash.hex()).string());
+	boost::split(lines, content, boost::is_any_of("\n"));
+	if (lines.empty() || lines.back() != "")
+		// Missing or incomplete file.
+		return {};
+	lines.pop_back();
+
+	Result result;
+	if (lines.front() == "sat")
+		result.first = CheckResult::SATISFIABLE;
+	else if (lines.front() == "unsat")
+		result.first = CheckResult::UNSATISFIABLE;
+	else
+		return {};
+	result.second.assign(lines.begin() + 1, lines.end());
+	return result;
+}
+
+void SMTQueryCache::writeToDirectory(h256 const& _hash, Result const& _result) const
+{
+	// Errors are ignored, the cache is only an optimisation.
+	boost::system::error_code error;
+	boost::filesystem::create_directories(m_directory, error);
+	// Write to a temporary file first, so that concurrent compiler runs never see
+	// partially written results.
+	boost::filesystem::path temporary = m_directory / boost::filesystem::unique_path("%%%%-%%%%-%%%%-%%%%.tmp");
+	ofstream file(temporary.string(), ios::binary);
+	file << (_result.first == CheckResult::SATISFIABLE ? "sat" : "unsat") << "\n";
+	for (string const& value: _result.second)
+		file << value << "\n";
+	file.close();
+	if (file)
+		boost::filesystem::rename(temporary, m_directory / _hash.hex(), error);
+	if (!file || error)
+		boost::filesystem::remove(temporary, error);
+}
@@ -0,0 +1,88 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <libsolidity/formal/SolverInterface.h>
+#include <libdevcore/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Cache of the results of SMT queries.
+ *
+ * Queries are given in SMT-LIB2 format and identified by the keccak256 hash of their
+ * normalised text, where all quoted symbols are renamed in the order of their first
+ * occurrence. Because of that, queries that only differ in the names of the variables
+ * (e.g. the same overflow check in different functions) share their result.
+ *
+ * Only answers (SAT or UNSAT) are cached, since the other results depend on the
+ * available solvers and on timeouts.
+ *
+ * If a directory is given, results are also read from and written to that directory
+ * (one file per query), so that they are shared between compiler runs.
+ *
+ * The cache can be used from multiple threads.
+ */
+class SMTQueryCache: public boost::noncopyable
+{
+public:
+	using Result = std::pair<CheckResult, std::vector<std::string>>;
+
+	explicit SMTQueryCache(boost::filesystem::path _directory = {});
+
+	/// @returns the result of @a _query if it is known.
+	boost::optional<Result> lookup(std::string const& _query);
+	/// Stores the result of @a _query. Ignores results that are not answers.
+	void store(std::string const& _query, Result const& _result);
+
+	/// @returns the number of lookups that found a result.
+	size_t hits() const { return m_hits; }
+	/// @returns the number of lookups that did not find a result.
+	size_t misses() const { return m_misses; }
+
+	/// @returns @a _query with all quoted symbols renamed in the order of their first occurrence.
+	static std::string normalise(std::string const& _query);
+
+private:
+	boost::optional<Result> readFromDirectory(h256 const& _hash) const;
+	void writeToDirectory(h256 const& _hash, Result const& _result) const;
+
+	boost::filesystem::path m_directory;
+	std::mutex m_mutex;
+	std::map<h256, Result> m_results;
+	size_t m_hits = 0;
+	size_t m_misses = 0;
+};
+
+}
+}
+}
@@ -0,0 +1,283 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTSolverProcessPool.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/algorithm/string.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+/// Output of the solver after the response to a query.
+string const c_endOfResponse = "solidity-smt-query-done";
+
+}
+
+#ifdef _WIN32
+
+struct SMTSolverProcessPool::Process
+{
+	enum class Status { Success, Timeout, Failure };
+
+	static unique_ptr<Process> start(vector<string> const&, string& _error)
+	{
+		_error = "External SMT solvers are not supported on this platform.";
+		return nullptr;
+	}
+
+	Status communicate(string const&, chrono::milliseconds, string&)
+	{
+		solAssert(false, "");
+	}
+};
+
+#else
+
+struct SMTSolverProcessPool::Process
+{
+	enum class Status { Success, Timeout, Failure };
+
+	~Process()
+	{
+		close(socket);
+		kill(pid, SIGKILL);
+		waitpid(pid, nullptr, 0);
+	}
+
+	/// Starts @a _command with its standard input and output connected to a socket.
+	/// @returns nullptr and sets @a _error if the command could not be started.
+	static unique_ptr<Process> start(vector<string> const& _command, string& _error)
+	{
+		vector<char*> arguments;
+		for (string const& argument: _command)
+			arguments.push_back(const_cast<char*>(argument.c_str()));
+		arguments.push_back(nullptr);
+
+		int sockets[2];
+		// Reports the error of exec to the parent. Closed on a successful exec.
+		int execError[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+		{
+			_error = string("Could not create socket: ") + strerror(errno);
+			return nullptr;
+		}
+		if (pipe(execError) != 0)
+		{
+			_error = string("Could not create pipe: ") + strerror(errno);
+			close(sockets[0]);
+			close(sockets[1]);
+			return nullptr;
+		}
+		// Other solver processes must not inherit the descriptors, otherwise they
+		// keep each other's sockets open.
+		for (int descriptor: {sockets[0], sockets[1], execError[0], execError[1]})
+			fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			// Only async-signal-safe functions may be used here.
+			if (dup2(sockets[1], STDIN_FILENO) >= 0 && dup2(sockets[1], STDOUT_FILENO) >= 0)
+				execvp(arguments.front(), arguments.data());
+			int error = errno;
+			if (write(execError[1], &error, sizeof(error))) {}
+			_exit(127);
+		}
+		int error = errno;
+		close(sockets[1]);
+		close(execError[1]);
+		if (pid < 0)
+		{
+			_error = string("Could not start SMT solver: ") + strerror(error);
+			close(sockets[0]);
+			close(execError[0]);
+			return nullptr;
+		}
+
+		auto process = make_unique<Process>();
+		process->pid = pid;
+		process->socket = sockets[0];
+		ssize_t count;
+		do
+			count = read(execError[0], &error, sizeof(error));
+		while (count < 0 && errno == EINTR);
+		close(execError[0]);
+		if (count > 0)
+		{
+			_error = "Could not start SMT solver \"" + _command.front() + "\": " + strerror(error);
+			return nullptr;
+		}
+		return process;
+	}
+
+	/// Sends @a _input to the process and stores its output up to the end marker in @a _response.
+	Status communicate(string const& _input, chrono::milliseconds _timeout, string& _response)
+	{
+		auto deadline = chrono::steady_clock::now() + _timeout;
+		// @returns false if the socket is not ready before the deadline.
+		auto wait = [&](short _events) {
+			pollfd descriptor{socket, _events, 0};
+			int ready;
+			do
+			{
+				int timeout = -1;
+				if (_timeout.count() > 0)
+					timeout = int(max<chrono::milliseconds::rep>(
+						0,
+						chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count()
+					));
+				ready = poll(&descriptor, 1, timeout);
+			}
+			while (ready < 0 && errno == EINTR);
+			return ready > 0;
+		};
+
+		for (size_t written = 0; written < _input.size();)
+		{
+			if (!wait(POLLOUT))
+				return Status::Timeout;
+			// MSG_NOSIGNAL avoids SIGPIPE if the solver terminated.
+			ssize_t count = send(socket, _input.data() + written, _input.size() - written, MSG_NOSIGNAL);
+			if (count < 0 && errno != EINTR && errno != EAGAIN)
+				return Status::Failure;
+			if (count > 0)
+				written += size_t(count);
+		}
+
+		_response.clear();
+		array<char, 4096> buffer;
+		while (!endOfResponse(_response))
+		{
+			if (!wait(POLLIN))
+				return Status::Timeout;
+			ssize_t count = recv(socket, buffer.data(), buffer.size(), 0);
+			if (count == 0 || (count < 0 && errno != EINTR && errno != EAGAIN))
+				return Status::Failure;
+			if (count > 0)
+				_response.append(buffer.data(), size_t(count));
+		}
+		return Status::Success;
+	}
+
+	/// @returns true if @a _output ends with the end marker and removes the marker.
+	static bool endOfResponse(string& _output)
+	{
+		// Some solvers print the argument of echo with quotes, some without.
+		for (string const& marker: {c_endOfResponse, "\"" + c_endOfResponse + "\""})
+			if (_output == marker + "\n" || boost::ends_with(_output, "\n" + marker + "\n"))
+			{
+				_output.resize(_output.size() - marker.size() - 1);
+				return true;
+			}
+		return false;
+	}
+
+	pid_t pid = -1;
+	/// Connected to both the standard input and the standard output of the process.
+	int socket = -1;
+};
+
+#endif
+
+SMTSolverProcessPool::SMTSolverProcessPool(
+	string const& _command,
+	size_t _maxProcesses,
+	chrono::milliseconds _timeout
+):
+	m_maxProcesses(max<size_t>(1, _maxProcesses)),
+	m_timeout(_timeout)
+{
+	string command = boost::trim_copy(_command);
+	boost::split(m_command, command, boost::is_space(), boost::token_compress_on);
+	solAssert(!command.empty(), "No SMT solver command given.");
+}
+
+SMTSolverProcessPool::~SMTSolverProcessPool() = default;
+
+ReadCallback::Result SMTSolverProcessPool::query(string const& _query)
+{
+	string error;
+	unique_ptr<Process> process = acquire(error);
+	if (!process)
+		return ReadCallback::Result{false, error};
+
+	string response;
+	switch (process->communicate("(reset)\n" + _query + "(echo \"" + c_endOfResponse + "\")\n", m_timeout, response))
+	{
+	case Process::Status::Success:
+		release(move(process));
+		return ReadCallback::Result{true, response};
+	case Process::Status::Timeout:
+		// The solver might still be busy with the query, so it cannot be reused.
+		release(nullptr);
+		return ReadCallback::Result{true, "unknown\n"};
+	case Process::Status::Failure:
+		release(nullptr);
+		return ReadCallback::Result{false, "SMT solver \"" + m_command.front() + "\" terminated unexpectedly."};
+	}
+	solAssert(false, "");
+}
+
+unique_ptr<SMTSolverProcessPool::Process> SMTSolverProcessPool::acquire(string& _error)
+{
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_processReleased.wait(lock, [&]() { return !m_idleProcesses.empty() || m_processes < m_maxProcesses; });
+		if (!m_idleProcesses.empty())
+		{
+			unique_ptr<Process> process = move(m_idleProcesses.back());
+			m_idleProcesses.pop_back();
+			return process;
+		}
+		++m_processes;
+	}
+	// Processes are started without holding the lock, so that other threads can use idle processes meanwhile.
+	unique_ptr<Process> process = Process::start(m_command, _error);
+	if (!process)
+		release(nullptr);
+	return process;
+}
+
+void SMTSolverProcessPool::release(unique_ptr<Process> _process)
+{
+	lock_guard<mutex> lock(m_mutex);
+	if (_process)
+		m_idleProcesses.emplace_back(move(_process));
+	else
+		--m_processes;
+	m_processReleased.notify_one();
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <libsolidity/interface/ReadFile.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Pool of external SMT solver processes that read SMT-LIB2 queries from their
+ * standard input and write the responses to their standard output (e.g. `z3 -in`).
+ *
+ * Processes are started on demand, up to the given number of processes, and reused
+ * for later queries. Each query is preceded by `(reset)` and followed by an `echo`
+ * command, whose output marks the end of the response.
+ *
+ * If a query takes longer than the timeout, its process is terminated and the
+ * response is "unknown".
+ *
+ * The pool can be used from multiple threads. It is not supported on Windows.
+ */
+class SMTSolverProcessPool: public boost::noncopyable
+{
+public:
+	/// @param _command the solver executable, which is searched for in PATH, followed
+	/// by its arguments, separated by whitespace.
+	/// @param _timeout the maximum duration of a query, no limit if zero.
+	SMTSolverProcessPool(
+		std::string const& _command,
+		size_t _maxProcesses,
+		std::chrono::milliseconds _timeout = std::chrono::milliseconds(0)
+	);
+	~SMTSolverProcessPool();
+
+	/// Sends @a _query to one of the solver processes.
+	/// @returns the response of the solver or an error message if the solver
+	/// could not be started or terminated unexpectedly.
+	ReadCallback::Result query(std::string const& _query);
+
+private:
+	struct Process;
+
+	/// @returns an idle process, starting a new one if there is none and the
+	/// maximum number of processes is not reached yet. Waits otherwise.
+	/// @returns nullptr and sets @a _error if the process could not be started.
+	std::unique_ptr<Process> acquire(std::string& _error);
+	/// Makes @a _process available to other queries, or frees its slot if it
+	/// was terminated.
+	void release(std::unique_ptr<Process> _process);
+
+	std::vector<std::string> m_command;
+	size_t m_maxProcesses;
+	std::chrono::milliseconds m_timeout;
+
+	std::mutex m_mutex;
+	std::condition_variable m_processReleased;
+	std::vector<std::unique_ptr<Process>> m_idleProcesses;
+	/// Number of processes that are either idle or in use.
+	size_t m_processes = 0;
+};
+
+}
+}
+}
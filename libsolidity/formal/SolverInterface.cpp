@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <unordered_map>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+
+Expression::Expression(string _name, vector<Expression> _arguments, SortPointer _sort)
+{
+	solAssert(_sort, "");
+	size_t hash = 0;
+	boost::hash_combine(hash, _name);
+	boost::hash_combine(hash, static_cast<int>(_sort->kind));
+	for (auto const& argument: _arguments)
+		boost::hash_combine(hash, argument.m_node.get());
+	m_node = intern(Node{move(_name), move(_arguments), move(_sort), hash});
+}
+
+shared_ptr<Expression::Node const> Expression::intern(Node&& _node)
+{
+	// Table of all existing nodes, indexed by their hash. Expressions are created
+	// from several threads by BMC's solver pool, so it is protected by a mutex.
+	// Entries of nodes that do not exist any more are removed whenever the
+	// table has doubled in size.
+	static mutex tableMutex;
+	static unordered_multimap<size_t, weak_ptr<Node const>> table;
+	static size_t const minSweepSize = 1024;
+	static size_t sweepSize = minSweepSize;
+
+	auto sameNode = [&](Node const& _other) {
+		if (
+			_other.name != _node.name ||
+			_other.arguments.size() != _node.arguments.size() ||
+			!(*_other.sort == *_node.sort)
+		)
+			return false;
+		for (size_t i = 0; i < _node.arguments.size(); ++i)
+			if (_other.arguments[i].m_node != _node.arguments[i].m_node)
+				return false;
+		return true;
+	};
+
+	lock_guard<mutex> lock(tableMutex);
+	auto range = table.equal_range(_node.hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (auto node = it->second.lock())
+			if (sameNode(*node))
+				return node;
+
+	auto node = make_shared<Node const>(move(_node));
+	table.emplace(node->hash, node);
+	if (table.size() > sweepSize)
+	{
+		for (auto it = table.begin(); it != table.end();)
+			if (it->second.expired())
+				it = table.erase(it);
+			else
+				++it;
+		sweepSize = max(minSweepSize, 2 * table.size());
+	}
+	return node;
+}
@@ -23,9 +23,12 @@
 #include <libdevcore/Exceptions.h>
 
 #include <boost/noncopyable.hpp>
+#include <chrono>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace dev
@@ -40,6 +43,38 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+/// @returns "sat", "unsat", "unknown", "conflicting" or "error".
+inline std::string checkResultName(CheckResult _result)
+{
+	switch (_result)
+	{
+	case CheckResult::SATISFIABLE: return "sat";
+	case CheckResult::UNSATISFIABLE: return "unsat";
+	case CheckResult::UNKNOWN: return "unknown";
+	case CheckResult::CONFLICTING: return "conflicting";
+	case CheckResult::ERROR: return "error";
+	}
+	solAssert(false, "");
+}
+
+/// Limits of a single check of a solver.
+struct SolverLimits
+{
+	/// Maximum duration in milliseconds, unlimited if zero.
+	unsigned timeout = 10000;
+	/// Maximum number of resource units (Z3's rlimit), unlimited if zero.
+	/// Unlike the timeout, it does not depend on the speed of the machine.
+	unsigned resourceLimit = 0;
+};
+
+/// Result and duration of a check of a single solver.
+struct SolverRun
+{
+	std::string solver;
+	CheckResult result;
+	std::chrono::milliseconds duration;
+};
+
 enum class Kind
 {
 	Int,
@@ -111,9 +146,14 @@ struct ArraySort: public Sort
 };
 
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are immutable and hash-consed: structurally equal expressions that
+/// exist at the same time share the same node, so copies are cheap and repeated
+/// subterms form a DAG. Solver interfaces use this to translate each node only once.
 class Expression
 {
 	friend class SolverInterface;
+	template <class> friend class ExpressionCache;
+	struct Node;
 public:
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	Expression(size_t _number): Expression(std::to_string(_number), Kind::Int) {}
@@ -126,34 +166,29 @@ public:
 	Expression& operator=(Expression const&) = default;
 	Expression& operator=(Expression&&) = default;
 
+	std::string const& name() const;
+	std::vector<Expression> const& arguments() const;
+	SortPointer const& sort() const;
+
 	bool hasCorrectArity() const
 	{
-		static std::map<std::string, unsigned> const operatorsArity{
-			{"ite", 3},
-			{"not", 1},
-			{"and", 2},
-			{"or", 2},
-			{"implies", 2},
-			{"=", 2},
-			{"<", 2},
-			{"<=", 2},
-			{">", 2},
-			{">=", 2},
-			{"+", 2},
-			{"-", 2},
-			{"*", 2},
-			{"/", 2},
-			{"mod", 2},
-			{"select", 2},
-			{"store", 3}
-		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return isOperator(name()) && operatorsArity().at(name()) == arguments().size();
+	}
+
+	/// @returns a hash of the expression. Structurally equal expressions have the same hash.
+	size_t hash() const;
+
+	/// @returns true if @a _name is the name of a built-in operator
+	/// and not of an uninterpreted function.
+	static bool isOperator(std::string const& _name)
+	{
+		return operatorsArity().count(_name);
 	}
 
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		solAssert(*_trueValue.sort == *_falseValue.sort, "");
-		SortPointer sort = _trueValue.sort;
+		solAssert(*_trueValue.sort() == *_falseValue.sort(), "");
+		SortPointer sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
 		}, std::move(sort));
@@ -172,11 +207,11 @@ public:
 	/// select is the SMT representation of an array index access.
 	static Expression select(Expression _array, Expression _index)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
 		return Expression(
 			"select",
 			std::vector<Expression>{std::move(_array), std::move(_index)},
@@ -188,13 +223,13 @@ public:
 	/// The function is pure and returns the modified array.
 	static Expression store(Expression _array, Expression _index, Expression _element)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(_element.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
-		solAssert(*arraySort->range == *_element.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(_element.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
+		solAssert(*arraySort->range == *_element.sort(), "");
 		return Expression(
 			"store",
 			std::vector<Expression>{std::move(_array), std::move(_index), std::move(_element)},
@@ -261,22 +296,42 @@ public:
 	Expression operator()(std::vector<Expression> _arguments) const
 	{
 		solAssert(
-			sort->kind == Kind::Function,
+			sort()->kind == Kind::Function,
 			"Attempted function application to non-function."
 		);
-		auto fSort = dynamic_cast<FunctionSort const*>(sort.get());
+		auto fSort = dynamic_cast<FunctionSort const*>(sort().get());
 		solAssert(fSort, "");
-		return Expression(name, std::move(_arguments), fSort->codomain);
+		return Expression(name(), std::move(_arguments), fSort->codomain);
 	}
 
-	std::string name;
-	std::vector<Expression> arguments;
-	SortPointer sort;
-
 private:
+	static std::map<std::string, unsigned> const& operatorsArity()
+	{
+		static std::map<std::string, unsigned> const operatorsArity{
+			{"ite", 3},
+			{"not", 1},
+			{"and", 2},
+			{"or", 2},
+			{"implies", 2},
+			{"=", 2},
+			{"<", 2},
+			{"<=", 2},
+			{">", 2},
+			{">=", 2},
+			{"+", 2},
+			{"-", 2},
+			{"*", 2},
+			{"/", 2},
+			{"mod", 2},
+			{"select", 2},
+			{"store", 3}
+		};
+		return operatorsArity;
+	}
+
 	/// Manual constructors, should only be used by SolverInterface and this class itself.
-	Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)) {}
+	/// Returns the existing node if there is a structurally equal one.
+	Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort);
 	Expression(std::string _name, std::vector<Expression> _arguments, Kind _kind):
 		Expression(std::move(_name), std::move(_arguments), std::make_shared<Sort>(_kind)) {}
 
@@ -286,6 +341,77 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _kind) {}
 	Expression(std::string _name, Expression _arg1, Expression _arg2, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
+
+	/// @returns the existing node that is structurally equal to @a _node or a new one.
+	static std::shared_ptr<Node const> intern(Node&& _node);
+
+	std::shared_ptr<Node const> m_node;
+};
+
+struct Expression::Node
+{
+	std::string name;
+	std::vector<Expression> arguments;
+	SortPointer sort;
+	size_t hash;
+};
+
+inline std::string const& Expression::name() const { return m_node->name; }
+inline std::vector<Expression> const& Expression::arguments() const { return m_node->arguments; }
+inline SortPointer const& Expression::sort() const { return m_node->sort; }
+inline size_t Expression::hash() const { return m_node->hash; }
+
+/**
+ * Cache of translations of expressions, e.g. into the expressions of a solver.
+ * Since expressions are hash-consed, each shared subterm is translated only once.
+ * The cache does not keep the expressions alive: translations of expressions
+ * that do not exist any more are removed whenever the cache has doubled in size.
+ */
+template <class T>
+class ExpressionCache
+{
+public:
+	/// @returns the translation of @a _expr or nullptr if there is none.
+	T const* find(Expression const& _expr) const
+	{
+		auto it = m_entries.find(_expr.m_node.get());
+		if (it == m_entries.end() || it->second.node.expired())
+			return nullptr;
+		return &it->second.value;
+	}
+
+	void insert(Expression const& _expr, T _value)
+	{
+		m_entries.erase(_expr.m_node.get());
+		m_entries.emplace(_expr.m_node.get(), Entry{_expr.m_node, std::move(_value)});
+		if (m_entries.size() > m_sweepSize)
+		{
+			for (auto it = m_entries.begin(); it != m_entries.end();)
+				if (it->second.node.expired())
+					it = m_entries.erase(it);
+				else
+					++it;
+			m_sweepSize = std::max(c_minSweepSize, 2 * m_entries.size());
+		}
+	}
+
+	void clear()
+	{
+		m_entries.clear();
+		m_sweepSize = c_minSweepSize;
+	}
+
+private:
+	static size_t constexpr c_minSweepSize = 1024;
+
+	struct Entry
+	{
+		/// The node cannot be freed and its address reused while it is referenced here.
+		std::weak_ptr<Expression::Node const> node;
+		T value;
+	};
+	std::unordered_map<Expression::Node const*, Entry> m_entries;
+	size_t m_sweepSize = c_minSweepSize;
 };
 
 DEV_SIMPLE_EXCEPTION(SolverError);
@@ -315,15 +441,47 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Like check(), but @a _assumptions (Boolean variables or their negations) are
+	/// only assumed to hold for this check. Solvers that support it keep what they
+	/// learnt during the check, so that later checks with different assumptions
+	/// are faster than with push() and pop().
+	virtual std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	)
+	{
+		if (_assumptions.empty())
+			return check(_expressionsToEvaluate);
+		push();
+		for (auto const& assumption: _assumptions)
+			addAssertion(assumption);
+		std::pair<CheckResult, std::vector<std::string>> result;
+		try
+		{
+			result = check(_expressionsToEvaluate);
+		}
+		catch (...)
+		{
+			pop();
+			throw;
+		}
+		pop();
+		return result;
+	}
+
+	/// Asks a running call to check() to stop as soon as possible, it then
+	/// returns UNKNOWN. Can be called from a different thread than check()
+	/// and has no effect if check() is not running.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
 
-protected:
-	// SMT query timeout in milliseconds.
-	static int const queryTimeout = 10000;
+	/// @returns the name of the solver used in telemetry.
+	virtual std::string name() const = 0;
 };
 
 }
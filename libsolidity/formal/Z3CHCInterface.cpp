@@ -24,15 +24,14 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-Z3CHCInterface::Z3CHCInterface():
-	m_z3Interface(make_shared<Z3Interface>()),
+Z3CHCInterface::Z3CHCInterface(SolverLimits const& _limits):
+	m_z3Interface(make_shared<Z3Interface>(_limits)),
 	m_context(m_z3Interface->context()),
 	m_solver(*m_context)
 {
 	// This needs to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
-	// This needs to be set in the context.
-	m_context->set("timeout", queryTimeout);
+	// The limits are set in the context by m_z3Interface.
 }
 
 void Z3CHCInterface::declareVariable(string const& _name, Sort const& _sort)
@@ -42,7 +41,7 @@ void Z3CHCInterface::declareVariable(string const& _name, Sort const& _sort)
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
 {
-	m_solver.register_relation(m_z3Interface->functions().at(_expr.name));
+	m_solver.register_relation(m_z3Interface->functions().at(_expr.name()));
 }
 
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
@@ -34,7 +34,7 @@ namespace smt
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface();
+	explicit Z3CHCInterface(SolverLimits const& _limits = {});
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, Sort const& _sort) override;
@@ -54,9 +54,6 @@ private:
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
-
-	// SMT query timeout in milliseconds.
-	static int const queryTimeout = 10000;
 };
 
 }
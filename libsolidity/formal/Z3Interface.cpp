@@ -24,13 +24,16 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
 
-Z3Interface::Z3Interface():
+Z3Interface::Z3Interface(SolverLimits const& _limits):
 	m_solver(m_context)
 {
 	// This needs to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
-	// This needs to be set in the context.
-	m_context.set("timeout", queryTimeout);
+	// These need to be set in the context.
+	if (_limits.timeout > 0)
+		m_context.set("timeout", to_string(_limits.timeout).c_str());
+	if (_limits.resourceLimit > 0)
+		m_context.set("rlimit", to_string(_limits.resourceLimit).c_str());
 }
 
 void Z3Interface::reset()
@@ -74,12 +77,23 @@ void Z3Interface::addAssertion(Expression const& _expr)
 }
 
 pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	return checkAssuming({}, _expressionsToEvaluate);
+}
+
+pair<CheckResult, vector<string>> Z3Interface::checkAssuming(
+	vector<Expression> const& _assumptions,
+	vector<Expression> const& _expressionsToEvaluate
+)
 {
 	CheckResult result;
 	vector<string> values;
 	try
 	{
-		switch (m_solver.check())
+		z3::expr_vector assumptions(m_context);
+		for (auto const& assumption: _assumptions)
+			assumptions.push_back(toZ3Expr(assumption));
+		switch (m_solver.check(assumptions))
 		{
 		case z3::check_result::sat:
 			result = CheckResult::SATISFIABLE;
@@ -110,15 +124,33 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	// The cache only lives for one translation: Z3 slows down considerably if
+	// the subterms of asserted formulas are still referenced from outside.
+	ExpressionCache<z3::expr> cache;
+	return toZ3Expr(_expr, cache);
+}
+
+z3::expr Z3Interface::toZ3Expr(Expression const& _expr, ExpressionCache<z3::expr>& _cache)
+{
+	if (z3::expr const* translation = _cache.find(_expr))
+		return *translation;
+
+	z3::expr translation = translate(_expr, _cache);
+	_cache.insert(_expr, translation);
+	return translation;
+}
+
+z3::expr Z3Interface::translate(Expression const& _expr, ExpressionCache<z3::expr>& _cache)
+{
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
-		arguments.push_back(toZ3Expr(arg));
+	for (auto const& arg: _expr.arguments())
+		arguments.push_back(toZ3Expr(arg, _cache));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		if (m_functions.count(n))
 			return m_functions.at(n)(arguments);
 		else if (m_constants.count(n))
@@ -31,7 +31,7 @@ namespace smt
 class Z3Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	Z3Interface();
+	explicit Z3Interface(SolverLimits const& _limits = {});
 
 	void reset() override;
 
@@ -42,7 +42,17 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	std::pair<CheckResult, std::vector<std::string>> checkAssuming(
+		std::vector<Expression> const& _assumptions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	) override;
 
+	void interrupt() override { m_context.interrupt(); }
+
+	std::string name() const override { return "z3"; }
+
+	/// @returns the translation of @a _expr. Subterms that occur several times
+	/// in @a _expr are translated only once.
 	z3::expr toZ3Expr(Expression const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
@@ -53,6 +63,9 @@ public:
 private:
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
+	z3::expr toZ3Expr(Expression const& _expr, ExpressionCache<z3::expr>& _cache);
+	z3::expr translate(Expression const& _expr, ExpressionCache<z3::expr>& _cache);
+
 	z3::sort z3Sort(smt::Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<smt::SortPointer> const& _sorts);
 
@@ -91,6 +91,7 @@ CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 
 CompilerStack::~CompilerStack()
 {
+	m_modelChecker.reset();
 	--g_compilerStackCounts;
 	TypeProvider::reset();
 }
@@ -166,13 +167,36 @@ void CompilerStack::addSMTLib2Response(h256 const& _hash, string const& _respons
 	m_smtlib2Responses[_hash] = _response;
 }
 
+void CompilerStack::setSMTQueryCache(shared_ptr<smt::SMTQueryCache> _queryCache)
+{
+	if (m_stackState >= ParsingPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the SMT query cache before parsing."));
+	m_smtQueryCache = move(_queryCache);
+}
+
+void CompilerStack::setSMTCallback(ReadCallback::Callback _smtCallback)
+{
+	if (m_stackState >= ParsingPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set the SMT callback before parsing."));
+	m_smtCallback = move(_smtCallback);
+}
+
+void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
+{
+	if (m_stackState >= ParsingPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set model checker settings before parsing."));
+	m_modelCheckerSettings = move(_settings);
+}
+
 void CompilerStack::reset(bool _keepSettings)
 {
+	m_modelChecker.reset();
 	m_stackState = Empty;
 	m_hasError = false;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
 	m_unhandledSMTLib2Queries.clear();
+	m_smtQueryTelemetry.clear();
 	if (!_keepSettings)
 	{
 		m_remappings.clear();
@@ -182,6 +206,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_generateEWasm = false;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
+		m_smtQueryCache.reset();
+		m_smtCallback = {};
+		m_modelCheckerSettings = ModelCheckerSettings{};
 	}
 	m_globalContext.reset();
 	m_scopes.clear();
@@ -371,10 +398,19 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
+			vector<SourceUnit const*> sources;
 			for (Source const* source: m_sourceOrder)
-				modelChecker.analyze(*source->ast);
-			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
+				sources.push_back(source->ast.get());
+			m_modelChecker = make_unique<ModelChecker>(
+				m_errorReporter,
+				m_smtlib2Responses,
+				m_smtCallback,
+				m_smtQueryCache,
+				m_modelCheckerSettings
+			);
+			m_modelChecker->start(sources);
+			if (!m_deferModelChecker)
+				finishModelChecker();
 		}
 	}
 	catch (FatalError const&)
@@ -427,8 +463,19 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 bool CompilerStack::compile()
 {
 	if (m_stackState < AnalysisPerformed)
+	{
+		// An asynchronous model checker keeps running during code generation.
+		m_deferModelChecker = m_modelCheckerSettings.asynchronous;
+		ScopeGuard deferModelChecker([&]() { m_deferModelChecker = false; });
 		if (!parseAndAnalyze())
+		{
+			finishModelChecker();
 			return false;
+		}
+	}
+
+	// Waits for the model checker without storing its results if code generation fails.
+	ScopeGuard stopModelChecker([&]() { m_modelChecker.reset(); });
 
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
@@ -440,17 +487,32 @@ bool CompilerStack::compile()
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
 				{
+					// The model checker must not access the AST meanwhile.
+					unique_lock<mutex> astLock;
+					if (m_modelChecker)
+						astLock = unique_lock<mutex>(m_modelChecker->astMutex());
 					compileContract(*contract, otherCompilers);
 					if (m_generateIR || m_generateEWasm)
 						generateIR(*contract);
 					if (m_generateEWasm)
 						generateEWasm(*contract);
 				}
+	finishModelChecker();
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+void CompilerStack::finishModelChecker()
+{
+	if (!m_modelChecker)
+		return;
+	m_modelChecker->finish();
+	m_unhandledSMTLib2Queries += m_modelChecker->unhandledQueries();
+	m_smtQueryTelemetry = m_modelChecker->queryTelemetry();
+	m_modelChecker.reset();
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -1129,6 +1191,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 	OptimiserSettings settingsWithoutRuns = m_optimiserSettings;
 	// reset to default
 	settingsWithoutRuns.expectedExecutionsPerDeployment = OptimiserSettings::minimal().expectedExecutionsPerDeployment;
+	settingsWithoutRuns.functionCallCounts.clear();
 	if (settingsWithoutRuns == OptimiserSettings::minimal())
 		meta["settings"]["optimizer"]["enabled"] = false;
 	else if (settingsWithoutRuns == OptimiserSettings::standard())
@@ -1143,6 +1206,8 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		details["deduplicate"] = m_optimiserSettings.runDeduplicate;
 		details["cse"] = m_optimiserSettings.runCSE;
 		details["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+		if (m_optimiserSettings.runSuperOptimiser)
+			details["superOptimizer"] = true;
 		details["yul"] = m_optimiserSettings.runYulOptimiser;
 		if (m_optimiserSettings.runYulOptimiser)
 		{
@@ -1152,6 +1217,13 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 
 		meta["settings"]["optimizer"]["details"] = std::move(details);
 	}
+	if (!m_optimiserSettings.functionCallCounts.empty())
+	{
+		Json::Value profile{Json::objectValue};
+		for (auto const& count: m_optimiserSettings.functionCallCounts)
+			profile[count.first] = Json::Value(Json::LargestUInt(count.second));
+		meta["settings"]["optimizer"]["profile"] = std::move(profile);
+	}
 
 	if (m_metadataLiteralSources)
 		meta["settings"]["metadata"]["useLiteralContent"] = true;
@@ -1392,18 +1464,19 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 	{
 		/// External functions
 		ContractDefinition const& contract = contractDefinition(_contractName);
+		eth::JumpTables const& jumpTables = this->contract(_contractName).compiler->runtimeJumpTables();
 		Json::Value externalFunctions(Json::objectValue);
 		for (auto it: contract.interfaceFunctions())
 		{
 			string sig = it.second->externalSignature();
-			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig));
+			externalFunctions[sig] = gasToJson(gasEstimator.functionalEstimation(*items, sig, jumpTables));
 		}
 
 		if (contract.fallbackFunction())
 			/// This needs to be set to an invalid signature in order to trigger the fallback,
 			/// without the shortcut (of CALLDATSIZE == 0), and therefore to receive the upper bound.
 			/// An empty string ("") would work to trigger the shortcut only.
-			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID"));
+			externalFunctions[""] = gasToJson(gasEstimator.functionalEstimation(*items, "INVALID", jumpTables));
 
 		if (!externalFunctions.empty())
 			output["external"] = externalFunctions;
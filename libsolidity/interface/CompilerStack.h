@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -64,6 +65,11 @@ using AssemblyItems = std::vector<AssemblyItem>;
 namespace solidity
 {
 
+namespace smt
+{
+class SMTQueryCache;
+}
+
 // forward declarations
 class ASTNode;
 class ContractDefinition;
@@ -71,6 +77,7 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class ModelChecker;
 class Natspec;
 class DeclarationContainer;
 
@@ -178,6 +185,17 @@ public:
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
 
+	/// Sets a cache for the results of the queries of the SMTChecker, which can be
+	/// shared between compilations. Must be set before parsing.
+	void setSMTQueryCache(std::shared_ptr<smt::SMTQueryCache> _queryCache);
+
+	/// Sets a callback that answers the SMTLib2 queries of the SMTChecker for which no
+	/// response was added. Must be set before parsing.
+	void setSMTCallback(ReadCallback::Callback _smtCallback);
+
+	/// Sets the limits of the SMTChecker. Must be set before parsing.
+	void setModelCheckerSettings(ModelCheckerSettings _settings);
+
 	/// Parses all source units that were added
 	/// @returns false on error.
 	bool parse();
@@ -217,6 +235,9 @@ public:
 	/// by calling @a addSMTLib2Response).
 	std::vector<std::string> const& unhandledSMTLib2Queries() const { return m_unhandledSMTLib2Queries; }
 
+	/// @returns the telemetry of the queries of the SMTChecker.
+	std::vector<QueryTelemetry> const& smtQueryTelemetry() const { return m_smtQueryTelemetry; }
+
 	/// @returns a list of the contract names in the sources.
 	std::vector<std::string> contractNames() const;
 
@@ -334,6 +355,9 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// Waits for the model checker if it is running and stores its results.
+	void finishModelChecker();
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -410,6 +434,14 @@ private:
 	std::map<std::string const, Source> m_sources;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
+	std::shared_ptr<smt::SMTQueryCache> m_smtQueryCache;
+	ReadCallback::Callback m_smtCallback;
+	ModelCheckerSettings m_modelCheckerSettings;
+	std::vector<QueryTelemetry> m_smtQueryTelemetry;
+	/// The model checker while it is running during code generation.
+	std::unique_ptr<ModelChecker> m_modelChecker;
+	/// If true, analyze() does not wait for the model checker.
+	bool m_deferModelChecker = false;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
@@ -67,9 +67,11 @@ public:
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
+	/// @a _jumpTables are the jump tables of the assembly, used by the function dispatcher.
 	GasConsumption functionalEstimation(
 		eth::AssemblyItems const& _items,
-		std::string const& _signature = ""
+		std::string const& _signature = "",
+		eth::JumpTables const& _jumpTables = eth::JumpTables()
 	) const;
 
 	/// @returns the estimated gas consumption by the given function which starts at the given
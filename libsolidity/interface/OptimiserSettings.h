@@ -23,6 +23,8 @@
 #pragma once
 
 #include <cstddef>
+#include <map>
+#include <string>
 
 namespace dev
 {
@@ -78,9 +80,11 @@ struct OptimiserSettings
 			runDeduplicate == _other.runDeduplicate &&
 			runCSE == _other.runCSE &&
 			runConstantOptimiser == _other.runConstantOptimiser &&
+			runSuperOptimiser == _other.runSuperOptimiser &&
 			optimizeStackAllocation == _other.optimizeStackAllocation &&
 			runYulOptimiser == _other.runYulOptimiser &&
-			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment;
+			expectedExecutionsPerDeployment == _other.expectedExecutionsPerDeployment &&
+			functionCallCounts == _other.functionCallCounts;
 	}
 
 	/// Move literals to the right of commutative binary operators during code generation.
@@ -97,6 +101,9 @@ struct OptimiserSettings
 	/// Constant optimizer, which tries to find better representations that satisfy the given
 	/// size/cost-trade-off.
 	bool runConstantOptimiser = false;
+	/// Search for cheaper equivalent replacements of short straight-line instruction sequences.
+	/// Slow, thus not part of the standard optimisations.
+	bool runSuperOptimiser = false;
 	/// Perform more efficient stack allocation for variables during code generation from Yul to bytecode.
 	bool optimizeStackAllocation = false;
 	/// Yul optimiser with default settings. Will only run on certain parts of the code for now.
@@ -104,6 +111,10 @@ struct OptimiserSettings
 	/// This specifies an estimate on how often each opcode in this assembly will be executed,
 	/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 	size_t expectedExecutionsPerDeployment = 200;
+	/// Execution profile: Number of calls of external functions (keyed by their signature)
+	/// in recorded or expected transactions. The function selector checks frequently called
+	/// functions first. Functions that are not listed are assumed to be called rarely.
+	std::map<std::string, size_t> functionCallCounts;
 };
 
 }
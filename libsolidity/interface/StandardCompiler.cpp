@@ -22,6 +22,7 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 
+#include <libsolidity/ast/ASTBinaryConverter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/SourceReferenceFormatter.h>
@@ -33,6 +34,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/optional.hpp>
 #include <algorithm>
+#include <sstream>
 
 using namespace std;
 using namespace dev;
@@ -74,6 +76,48 @@ Json::Value formatFatalError(string const& _type, string const& _message)
 	return output;
 }
 
+/// @returns a fatal error for the exception @a _exception thrown during compilation.
+Json::Value formatException(exception_ptr _exception)
+{
+	try
+	{
+		rethrow_exception(_exception);
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (Exception const& _exception)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+	}
+	catch (...)
+	{
+		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+	}
+}
+
+/// Parses @a _input into @a _json.
+/// @returns the serialized error output if @a _input is not valid JSON.
+boost::optional<string> parseJsonInput(string const& _input, Json::Value& _json)
+{
+	string errors;
+	try
+	{
+		if (!jsonParseStrict(_input, _json, &errors))
+			return jsonCompactPrint(formatFatalError("JSONError", errors));
+	}
+	catch (...)
+	{
+		return string("{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}");
+	}
+	return {};
+}
+
 Json::Value formatSourceLocation(SourceLocation const* location)
 {
 	Json::Value sourceLocation;
@@ -159,14 +203,14 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast", "astBinary"};
 	for (auto const& artifact: _outputSelection)
 		/// @TODO support sub-matching, e.g "evm" matches "evm.assembly"
 		if (artifact == _artifact)
 			return true;
 		else if (artifact == "*")
 		{
-			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
+			// "ir", "irOptimized", "wast", "ewasm.wast" and "astBinary" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
 		}
@@ -349,19 +393,19 @@ boost::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 boost::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
 boost::optional<Json::Value> checkOptimizerKeys(Json::Value const& _input)
 {
-	static set<string> keys{"details", "enabled", "runs"};
+	static set<string> keys{"details", "enabled", "runs", "profile"};
 	return checkKeys(_input, keys, "settings.optimizer");
 }
 
 boost::optional<Json::Value> checkOptimizerDetailsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "yul", "yulDetails"};
+	static set<string> keys{"peephole", "jumpdestRemover", "orderLiterals", "deduplicate", "cse", "constantOptimizer", "superOptimizer", "yul", "yulDetails"};
 	return checkKeys(_input, keys, "settings.optimizer.details");
 }
 
@@ -384,6 +428,12 @@ boost::optional<Json::Value> checkMetadataKeys(Json::Value const& _input)
 	return checkKeys(_input, keys, "settings.metadata");
 }
 
+boost::optional<Json::Value> checkModelCheckerKeys(Json::Value const& _input)
+{
+	static set<string> keys{"asynchronous", "functionSummaries", "resourceLimit", "telemetry", "threads", "timeout", "totalTimeout"};
+	return checkKeys(_input, keys, "settings.modelChecker");
+}
+
 boost::optional<Json::Value> checkOutputSelection(Json::Value const& _outputSelection)
 {
 	if (!!_outputSelection && !_outputSelection.isObject())
@@ -452,6 +502,22 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 		settings.expectedExecutionsPerDeployment = _jsonInput["runs"].asUInt();
 	}
 
+	if (_jsonInput.isMember("profile"))
+	{
+		Json::Value const& profile = _jsonInput["profile"];
+		if (!profile.isObject())
+			return formatFatalError("JSONError", "The \"profile\" setting must be an object.");
+		for (auto const& signature: profile.getMemberNames())
+		{
+			if (!profile[signature].isUInt())
+				return formatFatalError(
+					"JSONError",
+					"The number of calls of \"" + signature + "\" in \"settings.optimizer.profile\" must be an unsigned number."
+				);
+			settings.functionCallCounts[signature] = profile[signature].asUInt();
+		}
+	}
+
 	if (_jsonInput.isMember("details"))
 	{
 		Json::Value const& details = _jsonInput["details"];
@@ -470,6 +536,8 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 			return *error;
 		if (auto error = checkOptimizerDetail(details, "constantOptimizer", settings.runConstantOptimiser))
 			return *error;
+		if (auto error = checkOptimizerDetail(details, "superOptimizer", settings.runSuperOptimiser))
+			return *error;
 		if (auto error = checkOptimizerDetail(details, "yul", settings.runYulOptimiser))
 			return *error;
 		if (settings.runYulOptimiser)
@@ -663,6 +731,43 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 			ret.optimiserSettings = boost::get<OptimiserSettings>(std::move(optimiserSettings));
 	}
 
+	if (settings.isMember("modelChecker"))
+	{
+		Json::Value const& modelChecker = settings["modelChecker"];
+		if (auto result = checkModelCheckerKeys(modelChecker))
+			return *result;
+		for (auto const& limit: map<string, unsigned*>{
+			{"resourceLimit", &ret.modelCheckerSettings.solverLimits.resourceLimit},
+			{"threads", &ret.modelCheckerSettings.threads},
+			{"timeout", &ret.modelCheckerSettings.solverLimits.timeout},
+			{"totalTimeout", &ret.modelCheckerSettings.totalTimeout}
+		})
+			if (modelChecker.isMember(limit.first))
+			{
+				if (!modelChecker[limit.first].isUInt())
+					return formatFatalError("JSONError", "\"settings.modelChecker." + limit.first + "\" must be an unsigned number.");
+				*limit.second = modelChecker[limit.first].asUInt();
+			}
+		if (modelChecker.isMember("functionSummaries"))
+		{
+			if (!modelChecker["functionSummaries"].isBool())
+				return formatFatalError("JSONError", "\"settings.modelChecker.functionSummaries\" must be a Boolean.");
+			ret.modelCheckerSettings.functionSummaries = modelChecker["functionSummaries"].asBool();
+		}
+		if (modelChecker.isMember("asynchronous"))
+		{
+			if (!modelChecker["asynchronous"].isBool())
+				return formatFatalError("JSONError", "\"settings.modelChecker.asynchronous\" must be a Boolean.");
+			ret.modelCheckerSettings.asynchronous = modelChecker["asynchronous"].asBool();
+		}
+		if (modelChecker.isMember("telemetry"))
+		{
+			if (!modelChecker["telemetry"].isBool())
+				return formatFatalError("JSONError", "\"settings.modelChecker.telemetry\" must be a Boolean.");
+			ret.modelCheckerTelemetry = modelChecker["telemetry"].asBool();
+		}
+	}
+
 	Json::Value jsonLibraries = settings.get("libraries", Json::Value(Json::objectValue));
 	if (!jsonLibraries.isObject())
 		return formatFatalError("JSONError", "\"libraries\" is not a JSON object.");
@@ -721,7 +826,7 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, JsonWriter& _output)
 {
 	CompilerStack compilerStack(m_readFile);
 
@@ -733,6 +838,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
 	compilerStack.setRemappings(_inputsAndSettings.remappings);
 	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 	compilerStack.setLibraries(_inputsAndSettings.libraries);
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
@@ -852,113 +958,169 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	/// Inconsistent state - stop here to receive error reports from users
 	if (((binariesRequested && !compilationSuccess) || !analysisPerformed) && errors.empty())
-		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
+	{
+		_output.writeMembers(formatFatalError("InternalCompilerError", "No error reported, but compilation failed."));
+		return;
+	}
 
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	// The output is written member by member in sorted key order, so that each artifact
+	// can be released as soon as it has been written.
 
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value queries = Json::objectValue;
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + keccak256(query).hex()] = query;
+			queries["0x" + keccak256(query).hex()] = query;
+		_output.beginObject("auxiliaryInputRequested");
+		_output.write("smtlib2queries", std::move(queries));
+		_output.endObject();
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisPerformed ? compilerStack.sourceNames() : vector<string>())
-	{
-		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
-	}
-
-	Json::Value contractsOutput = Json::objectValue;
+	map<string, vector<string>> contractsByFile;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
-
-		// ABI, documentation and metadata
-		Json::Value contractData(Json::objectValue);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
-
-		// IR
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
-
-		// eWasm
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
-			contractData["ewasm"]["wast"] = compilerStack.eWasm(contractName);
-
-		// EVM
-		Json::Value evmData(Json::objectValue);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
-		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
-
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" },
-			wildcardMatchesExperimental
-		))
-			evmData["bytecode"] = collectEVMObject(
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName)
-			);
+		contractsByFile[contractName.substr(0, colon)].push_back(contractName.substr(colon + 1));
+	}
 
-		if (compilationSuccess && isArtifactRequested(
-			_inputsAndSettings.outputSelection,
-			file,
-			name,
-			{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" },
-			wildcardMatchesExperimental
-		))
-			evmData["deployedBytecode"] = collectEVMObject(
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName)
-			);
+	bool contractsStarted = false;
+	for (auto const& fileAndNames: contractsByFile)
+	{
+		string const& file = fileAndNames.first;
+		bool fileStarted = false;
+		for (string const& name: fileAndNames.second)
+		{
+			string const contractName = file + ":" + name;
+
+			// ABI, documentation and metadata
+			Json::Value contractData(Json::objectValue);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
+				contractData["abi"] = compilerStack.contractABI(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
+				contractData["metadata"] = compilerStack.metadata(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
+				contractData["userdoc"] = compilerStack.natspecUser(contractName);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
+				contractData["devdoc"] = compilerStack.natspecDev(contractName);
+
+			// IR
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
+				contractData["ir"] = compilerStack.yulIR(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
+				contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+
+			// eWasm
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
+				contractData["ewasm"]["wast"] = compilerStack.eWasm(contractName);
+
+			// EVM
+			Json::Value evmData(Json::objectValue);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
+				evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
+				evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName, sourceList);
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
+				evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
+			if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
+				evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				{ "evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap", "evm.bytecode.linkReferences" },
+				wildcardMatchesExperimental
+			))
+				evmData["bytecode"] = collectEVMObject(
+					compilerStack.object(contractName),
+					compilerStack.sourceMapping(contractName)
+				);
+
+			if (compilationSuccess && isArtifactRequested(
+				_inputsAndSettings.outputSelection,
+				file,
+				name,
+				{ "evm.deployedBytecode", "evm.deployedBytecode.object", "evm.deployedBytecode.opcodes", "evm.deployedBytecode.sourceMap", "evm.deployedBytecode.linkReferences" },
+				wildcardMatchesExperimental
+			))
+				evmData["deployedBytecode"] = collectEVMObject(
+					compilerStack.runtimeObject(contractName),
+					compilerStack.runtimeSourceMapping(contractName)
+				);
+
+			if (!evmData.empty())
+				contractData["evm"] = std::move(evmData);
 
-		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			if (contractData.empty())
+				continue;
+
+			if (!contractsStarted)
+			{
+				_output.beginObject("contracts");
+				contractsStarted = true;
+			}
+			if (!fileStarted)
+			{
+				_output.beginObject(file);
+				fileStarted = true;
+			}
+			_output.write(name, std::move(contractData));
+		}
+		if (fileStarted)
+			_output.endObject();
+	}
+	if (contractsStarted)
+		_output.endObject();
+
+	if (errors.size() > 0)
+		_output.write("errors", std::move(errors));
 
-		if (!contractData.empty())
+	if (_inputsAndSettings.modelCheckerTelemetry)
+	{
+		Json::Value queries = Json::arrayValue;
+		for (QueryTelemetry const& telemetry: compilerStack.smtQueryTelemetry())
 		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
+			Json::Value query = Json::objectValue;
+			query["target"] = telemetry.target;
+			query["sourceLocation"] = formatSourceLocation(&telemetry.location);
+			query["result"] = smt::checkResultName(telemetry.result);
+			query["duration"] = Json::Int64(telemetry.duration.count());
+			query["solvers"] = Json::arrayValue;
+			for (smt::SolverRun const& run: telemetry.solvers)
+			{
+				Json::Value solver = Json::objectValue;
+				solver["name"] = run.solver;
+				solver["result"] = smt::checkResultName(run.result);
+				solver["duration"] = Json::Int64(run.duration.count());
+				query["solvers"].append(std::move(solver));
+			}
+			queries.append(std::move(query));
 		}
+		_output.beginObject("modelChecker");
+		_output.write("queries", std::move(queries));
+		_output.endObject();
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	_output.beginObject("sources");
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: analysisPerformed ? compilerStack.sourceNames() : vector<string>())
+	{
+		Json::Value sourceResult = Json::objectValue;
+		sourceResult["id"] = sourceIndex++;
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "astBinary", wildcardMatchesExperimental))
+			sourceResult["astBinary"] = toHex(ASTBinaryConverter(compilerStack.sourceIndices()).toBinary(compilerStack.ast(sourceName)));
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
+			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+		_output.write(sourceName, std::move(sourceResult));
+	}
+	_output.endObject();
 }
 
-
 Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 {
 	if (_inputsAndSettings.sources.size() != 1)
@@ -1035,65 +1197,103 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 }
 
 
-Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+void StandardCompiler::compile(Json::Value const& _input, JsonWriter& _output)
 {
 	YulStringRepository::reset();
 
-	try
+	auto parsed = parseInput(_input);
+	if (parsed.type() == typeid(Json::Value))
+		_output.writeMembers(boost::get<Json::Value>(parsed));
+	else
 	{
-		auto parsed = parseInput(_input);
-		if (parsed.type() == typeid(Json::Value))
-			return boost::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = boost::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			compileSolidity(std::move(settings), _output);
 		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
+			_output.writeMembers(compileYul(std::move(settings)));
 		else
-			return formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language.");
+			_output.writeMembers(formatFatalError("JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language."));
 	}
-	catch (Json::LogicError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON logic exception: ") + _exception.what());
-	}
-	catch (Json::RuntimeError const& _exception)
-	{
-		return formatFatalError("InternalCompilerError", string("JSON runtime exception: ") + _exception.what());
-	}
-	catch (Exception const& _exception)
+}
+
+Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
+{
+	try
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		Json::Value output;
+		JsonWriter writer(output);
+		writer.beginObject();
+		compile(_input, writer);
+		writer.endObject();
+		return output;
 	}
 	catch (...)
 	{
-		return formatFatalError("InternalCompilerError", "Internal exception in StandardCompiler::compile");
+		return formatException(current_exception());
 	}
 }
 
 string StandardCompiler::compile(string const& _input) noexcept
 {
 	Json::Value input;
-	string errors;
+	if (auto errorOutput = parseJsonInput(_input, input))
+		return *errorOutput;
+
 	try
 	{
-		if (!jsonParseStrict(_input, input, &errors))
-			return jsonCompactPrint(formatFatalError("JSONError", errors));
+		ostringstream output;
+		JsonWriter writer(output);
+		writer.beginObject();
+		compile(input, writer);
+		writer.endObject();
+		return output.str();
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		try
+		{
+			return jsonCompactPrint(formatException(current_exception()));
+		}
+		catch (...)
+		{
+			return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		}
 	}
+}
 
-	// cout << "Input: " << input.toStyledString() << endl;
-	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
+bool StandardCompiler::compile(string const& _input, ostream& _output) noexcept
+{
+	Json::Value input;
+	if (auto errorOutput = parseJsonInput(_input, input))
+	{
+		_output << *errorOutput;
+		return true;
+	}
 
 	try
 	{
-		return jsonCompactPrint(output);
+		JsonWriter writer(_output);
+		writer.beginObject();
+		try
+		{
+			compile(input, writer);
+		}
+		catch (...)
+		{
+			// Once members have been streamed, the error cannot be reported anymore
+			// without producing invalid JSON.
+			if (writer.started())
+			{
+				writer.close();
+				return false;
+			}
+			writer.writeMembers(formatException(current_exception()));
+		}
+		writer.endObject();
+		return true;
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		return false;
 	}
 }
@@ -24,6 +24,8 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <libdevcore/JSON.h>
+
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
@@ -54,6 +56,11 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Parses input as JSON and performs the above processing steps, streaming the serialized
+	/// output to @a _output as the artifacts are produced instead of building it in memory first.
+	/// @returns false if an internal error occurred after parts of the output had already been
+	/// written. In that case, all open objects are closed but the output is incomplete.
+	bool compile(std::string const& _input, std::ostream& _output) noexcept;
 
 private:
 	struct InputsAndSettings
@@ -66,6 +73,8 @@ private:
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
+		ModelCheckerSettings modelCheckerSettings;
+		bool modelCheckerTelemetry = false;
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
@@ -75,7 +84,10 @@ private:
 	/// it in condensed form or an error as a json object.
 	boost::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Performs the processing steps for @a _input and writes the members of the output object.
+	void compile(Json::Value const& _input, JsonWriter& _output);
+
+	void compileSolidity(InputsAndSettings _inputsAndSettings, JsonWriter& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
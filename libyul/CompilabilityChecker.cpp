@@ -22,6 +22,8 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmData.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/NoOutputAssembly.h>
@@ -81,3 +83,55 @@ map<YulString, int> CompilabilityChecker::run(
 	else
 		return {};
 }
+
+map<YulString, int> CompilabilityChecker::run(
+	Dialect const& _dialect,
+	Object const& _object,
+	bool _optimizeStackAllocation,
+	set<YulString> const& _functions
+)
+{
+	yulAssert(
+		_object.code &&
+		_object.code->statements.size() > 0 && _object.code->statements.at(0).type() == typeid(Block),
+		"Need to run the function grouper before checking individual functions."
+	);
+
+	// Check a copy of the object that only contains the requested functions.
+	// All other functions are replaced by stubs with an empty body, so that
+	// calls to them can still be analyzed.
+	Object reduced;
+	reduced.subObjects = _object.subObjects;
+	reduced.subIndexByName = _object.subIndexByName;
+	reduced.code = make_shared<Block>();
+	reduced.code->location = _object.code->location;
+	reduced.code->statements.reserve(_object.code->statements.size());
+
+	Block const& mainBlock = boost::get<Block>(_object.code->statements.front());
+	if (_functions.count({}))
+		reduced.code->statements.emplace_back(ASTCopier{}.translate(_object.code->statements.front()));
+	else
+		reduced.code->statements.emplace_back(Block{mainBlock.location, {}});
+	for (size_t i = 1; i < _object.code->statements.size(); ++i)
+	{
+		FunctionDefinition const& function = boost::get<FunctionDefinition>(_object.code->statements[i]);
+		if (_functions.count(function.name))
+			reduced.code->statements.emplace_back(ASTCopier{}.translate(_object.code->statements[i]));
+		else
+			reduced.code->statements.emplace_back(FunctionDefinition{
+				function.location,
+				function.name,
+				function.parameters,
+				function.returnVariables,
+				Block{function.body.location, {}}
+			});
+	}
+
+	map<YulString, int> result = run(_dialect, reduced, _optimizeStackAllocation);
+	for (auto it = result.begin(); it != result.end();)
+		if (_functions.count(it->first))
+			++it;
+		else
+			it = result.erase(it);
+	return result;
+}
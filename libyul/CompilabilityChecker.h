@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 namespace yul
 {
@@ -48,6 +49,19 @@ public:
 		Object const& _object,
 		bool _optimizeStackAllocation
 	);
+
+	/// Only checks the functions in @a _functions, where the empty name denotes the
+	/// outermost block. This yields the same results for these functions as checking the whole
+	/// object, since stack errors inside a function only depend on the function itself.
+	/// As with the full check, functions are not checked if the outermost block is requested
+	/// and cannot be compiled.
+	/// Requires the code to be in the form produced by the FunctionGrouper.
+	static std::map<YulString, int> run(
+		Dialect const& _dialect,
+		Object const& _object,
+		bool _optimizeStackAllocation,
+		std::set<YulString> const& _functions
+	);
 };
 
 }
@@ -171,16 +171,30 @@ void CodeTransform::deleteVariable(Scope::Variable const& _var)
 	m_variablesScheduledForDeletion.erase(&_var);
 }
 
+bool CodeTransform::canConsume(YulString _name, Scope::Variable const& _var)
+{
+	if (!m_allowStackOpt || m_visitingLoopCondition || !m_scope->identifiers.count(_name))
+		return false;
+	solAssert(m_context->variableReferences.count(&_var), "");
+	int const slot = m_context->variableStackHeights.at(&_var);
+	// If the slot below is unused, consuming the variable would expose it at the top
+	// of the stack, where a nested block (e.g. the body of an if statement) would pop it.
+	return
+		m_context->variableReferences.at(&_var) == 1 &&
+		m_assembly.stackHeight() - slot == 1 &&
+		!m_unusedStackSlots.count(slot - 1);
+}
+
 void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 {
 	solAssert(m_scope, "");
 
 	int const numVariables = _varDecl.variables.size();
-	int height = m_assembly.stackHeight();
 	if (_varDecl.value)
 	{
+		int depositHeightBefore = depositHeight();
 		boost::apply_visitor(*this, *_varDecl.value);
-		expectDeposit(numVariables, height);
+		expectDeposit(numVariables, depositHeightBefore);
 	}
 	else
 	{
@@ -188,6 +202,8 @@ void CodeTransform::operator()(VariableDeclaration const& _varDecl)
 		while (variablesLeft--)
 			m_assembly.appendConstant(u256(0));
 	}
+	// The value can use the stack slot of a variable that was consumed.
+	int const height = m_assembly.stackHeight() - numVariables;
 
 	bool atTopOfStack = true;
 	for (int varIndex = numVariables - 1; varIndex >= 0; --varIndex)
@@ -241,7 +257,7 @@ void CodeTransform::stackError(StackTooDeepError _error, int _targetStackHeight)
 
 void CodeTransform::operator()(Assignment const& _assignment)
 {
-	int height = m_assembly.stackHeight();
+	int height = depositHeight();
 	boost::apply_visitor(*this, *_assignment.value);
 	expectDeposit(_assignment.variableNames.size(), height);
 
@@ -364,8 +380,14 @@ void CodeTransform::operator()(Identifier const& _identifier)
 	if (m_scope->lookup(_identifier.name, Scope::NonconstVisitor(
 		[=](Scope::Variable& _var)
 		{
-			// TODO: opportunity for optimization: Do not DUP if this is the last reference
-			// to the top most element of the stack
+			if (canConsume(_identifier.name, _var))
+			{
+				// Instead of copying the variable, its stack slot is handed over to the expression.
+				m_context->variableStackHeights.erase(&_var);
+				m_context->variableReferences.erase(&_var);
+				--m_stackAdjustment;
+				return;
+			}
 			if (int heightDiff = variableHeightDiff(_var, _identifier.name, false))
 				m_assembly.appendInstruction(dev::eth::dupInstruction(heightDiff));
 			else
@@ -608,7 +630,9 @@ void CodeTransform::operator()(ForLoop const& _forLoop)
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendLabel(loopStart);
 
+	m_visitingLoopCondition = true;
 	visitExpression(*_forLoop.condition);
+	m_visitingLoopCondition = false;
 	m_assembly.setSourceLocation(_forLoop.location);
 	m_assembly.appendInstruction(dev::eth::Instruction::ISZERO);
 	m_assembly.appendJumpToIf(loopEnd);
@@ -716,7 +740,7 @@ AbstractAssembly::LabelID CodeTransform::functionEntryID(YulString _name, Scope:
 
 void CodeTransform::visitExpression(Expression const& _expression)
 {
-	int height = m_assembly.stackHeight();
+	int height = depositHeight();
 	boost::apply_visitor(*this, _expression);
 	expectDeposit(1, height);
 }
@@ -830,7 +854,7 @@ int CodeTransform::variableHeightDiff(Scope::Variable const& _var, YulString _va
 
 void CodeTransform::expectDeposit(int _deposit, int _oldHeight) const
 {
-	solAssert(m_assembly.stackHeight() == _oldHeight + _deposit, "Invalid stack deposit.");
+	solAssert(depositHeight() == _oldHeight + _deposit, "Invalid stack deposit.");
 }
 
 void CodeTransform::checkStackHeight(void const* _astElement) const
@@ -169,6 +169,10 @@ protected:
 	void freeUnusedVariables();
 	/// Marks the stack slot of @a _var to be reused.
 	void deleteVariable(Scope::Variable const& _var);
+	/// @returns true if the variable @a _var with name @a _name is on top of the stack,
+	/// is referenced for the last time and was defined in the current scope, i.e. if
+	/// its stack slot can be used directly instead of a copy.
+	bool canConsume(YulString _name, Scope::Variable const& _var);
 
 public:
 	void operator()(Instruction const& _instruction);
@@ -212,6 +216,9 @@ private:
 	/// the (positive) stack height difference otherwise.
 	int variableHeightDiff(Scope::Variable const& _var, YulString _name, bool _forSwap);
 
+	/// @returns the stack height without the variables that were consumed by expressions,
+	/// i.e. the height that expressions and statements deposit their values relative to.
+	int depositHeight() const { return m_assembly.stackHeight() - m_stackAdjustment; }
 	void expectDeposit(int _deposit, int _oldHeight) const;
 
 	void checkStackHeight(void const* _astElement) const;
@@ -245,6 +252,9 @@ private:
 	/// statement level in the scope where the variable was defined.
 	std::set<Scope::Variable const*> m_variablesScheduledForDeletion;
 	std::set<int> m_unusedStackSlots;
+	/// True while the condition of a for loop is visited. The condition is evaluated
+	/// repeatedly, so variables must not be consumed there.
+	bool m_visitingLoopCondition = false;
 
 	std::vector<StackTooDeepError> m_stackErrors;
 };
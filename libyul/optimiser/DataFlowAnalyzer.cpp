@@ -97,6 +97,14 @@ void DataFlowAnalyzer::operator()(VariableDeclaration& _varDecl)
 	}
 
 	handleAssignment(names, _varDecl.value.get());
+
+	if (_varDecl.value && _varDecl.variables.size() == 1)
+	{
+		if (auto key = isSimpleLoad(dev::eth::Instruction::SLOAD, *_varDecl.value))
+			m_storage.set(*key, _varDecl.variables.front().name);
+		else if (auto contents = keccakContents(*_varDecl.value))
+			m_keccakContents[_varDecl.variables.front().name] = std::move(*contents);
+	}
 }
 
 void DataFlowAnalyzer::operator()(If& _if)
@@ -146,10 +154,12 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	InvertibleRelation<YulString> references;
 	InvertibleMap<YulString, YulString> storage;
 	InvertibleMap<YulString, YulString> memory;
+	map<YulString, vector<YulString>> keccakContents;
 	m_value.swap(value);
 	swap(m_references, references);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	swap(m_keccakContents, keccakContents);
 	pushScope(true);
 
 	for (auto const& parameter: _fun.parameters)
@@ -166,6 +176,7 @@ void DataFlowAnalyzer::operator()(FunctionDefinition& _fun)
 	swap(m_references, references);
 	swap(m_storage, storage);
 	swap(m_memory, memory);
+	swap(m_keccakContents, keccakContents);
 }
 
 void DataFlowAnalyzer::operator()(ForLoop& _for)
@@ -283,6 +294,16 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 		m_memory.eraseValue(name);
 	}
 
+	// The hash itself or one of the hashed values changes.
+	for (auto it = m_keccakContents.begin(); it != m_keccakContents.end();)
+		if (
+			_variables.count(it->first) ||
+			any_of(it->second.begin(), it->second.end(), [&](YulString _v) { return _variables.count(_v); })
+		)
+			it = m_keccakContents.erase(it);
+		else
+			++it;
+
 	// Also clear variables that reference variables to be cleared.
 	for (auto const& name: _variables)
 		for (auto const& ref: m_references.backward[name])
@@ -297,7 +318,7 @@ void DataFlowAnalyzer::clearValues(set<YulString> _variables)
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 {
-	SideEffectsCollector sideEffects(m_dialect, _block);
+	SideEffectsCollector sideEffects(m_dialect, _block, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
 		m_storage.clear();
 	if (sideEffects.invalidatesMemory())
@@ -306,7 +327,7 @@ void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Block const& _block)
 
 void DataFlowAnalyzer::clearKnowledgeIfInvalidated(Expression const& _expr)
 {
-	SideEffectsCollector sideEffects(m_dialect, _expr);
+	SideEffectsCollector sideEffects(m_dialect, _expr, &m_functionSideEffects);
 	if (sideEffects.invalidatesStorage())
 		m_storage.clear();
 	if (sideEffects.invalidatesMemory())
@@ -383,3 +404,61 @@ boost::optional<pair<YulString, YulString>> DataFlowAnalyzer::isSimpleStore(
 	return {};
 }
 
+boost::optional<YulString> DataFlowAnalyzer::isSimpleLoad(
+	dev::eth::Instruction _load,
+	Expression const& _expression
+) const
+{
+	yulAssert(
+		_load == dev::eth::Instruction::MLOAD ||
+		_load == dev::eth::Instruction::SLOAD,
+		""
+	);
+	if (_expression.type() == typeid(FunctionCall))
+	{
+		FunctionCall const& funCall = boost::get<FunctionCall>(_expression);
+		if (EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect))
+			if (auto const* builtin = dialect->builtin(funCall.functionName.name))
+				if (builtin->instruction == _load && funCall.arguments.at(0).type() == typeid(Identifier))
+					return boost::get<Identifier>(funCall.arguments.at(0)).name;
+	}
+	return {};
+}
+
+boost::optional<vector<YulString>> DataFlowAnalyzer::keccakContents(Expression const& _expression)
+{
+	if (_expression.type() != typeid(FunctionCall))
+		return {};
+	FunctionCall const& funCall = boost::get<FunctionCall>(_expression);
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!dialect)
+		return {};
+	auto const* builtin = dialect->builtin(funCall.functionName.name);
+	if (
+		!builtin ||
+		builtin->instruction != dev::eth::Instruction::KECCAK256 ||
+		funCall.arguments.at(0).type() != typeid(Identifier) ||
+		funCall.arguments.at(1).type() != typeid(Identifier)
+	)
+		return {};
+	YulString start = boost::get<Identifier>(funCall.arguments.at(0)).name;
+	boost::optional<u256> length =
+		m_knowledgeBase.valueIfKnownConstant(boost::get<Identifier>(funCall.arguments.at(1)).name);
+	// Only consider short hashes like the ones used for mapping and array slots.
+	if (!length || *length == 0 || *length > 4 * 32 || *length % 32 != 0)
+		return {};
+
+	vector<YulString> contents(size_t(*length / 32));
+	vector<bool> found(contents.size(), false);
+	for (auto const& item: m_memory.values)
+		if (auto difference = m_knowledgeBase.differenceIfKnownConstant(item.first, start))
+			if (*difference < *length && *difference % 32 == 0)
+			{
+				size_t index = size_t(*difference / 32);
+				contents[index] = item.second;
+				found[index] = true;
+			}
+	if (find(found.begin(), found.end(), false) != found.end())
+		return {};
+	return contents;
+}
@@ -24,6 +24,7 @@
 
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/KnowledgeBase.h>
+#include <libyul/SideEffects.h>
 #include <libyul/YulString.h>
 #include <libyul/AsmData.h>
 
@@ -55,6 +56,13 @@ struct Dialect;
  *   where we cannot prove x != t or y == m_storage[t] using the current values of the variables x and t.
  * Otherwise, determine if the statement invalidates storage/memory. If yes, clear all knowledge
  * about storage/memory before visiting the statement. Then visit the statement.
+ * Calls to user-defined functions only invalidate storage/memory according to their
+ * side-effects, if they are provided.
+ * For variable declarations of the form ``let x := sload(y)``, record that the storage slot y
+ * contains x.
+ * For variable declarations of the form ``let x := keccak256(p, n)``, where n is a small
+ * constant multiple of 32 and the memory contents at p are known, record that x is the
+ * hash of these contents.
  *
  * For forward-joining control flow, storage/memory information from the branches is combined.
  * If the keys or values are different or non-existent in one branch, the key is deleted.
@@ -67,8 +75,15 @@ struct Dialect;
 class DataFlowAnalyzer: public ASTModifier
 {
 public:
-	explicit DataFlowAnalyzer(Dialect const& _dialect):
+	/// @param _functionSideEffects
+	///            Side-effects of user-defined functions. Worst-case side-effects are assumed
+	///            if this is not provided or the function is not found.
+	explicit DataFlowAnalyzer(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects = {}
+	):
 		m_dialect(_dialect),
+		m_functionSideEffects(std::move(_functionSideEffects)),
 		m_knowledgeBase(_dialect, m_value)
 	{}
 
@@ -123,7 +138,22 @@ protected:
 		ExpressionStatement const& _statement
 	) const;
 
+	/// @returns the key if the expression is of the form ``sload(k)`` / ``mload(k)``
+	/// (depending on @a _load) with an identifier ``k``.
+	boost::optional<YulString> isSimpleLoad(
+		dev::eth::Instruction _load,
+		Expression const& _expression
+	) const;
+
+	/// @returns the values currently stored in memory (one variable per 32 bytes) that are
+	/// hashed by @a _expression if it is of the form ``keccak256(p, n)`` with identifiers
+	/// ``p`` and ``n``, the value of ``n`` is a known small multiple of 32 and all these
+	/// memory words are known.
+	boost::optional<std::vector<YulString>> keccakContents(Expression const& _expression);
+
 	Dialect const& m_dialect;
+	/// Side-effects of user-defined functions.
+	std::map<YulString, SideEffects> m_functionSideEffects;
 
 	/// Current values of variables, always movable.
 	std::map<YulString, Expression const*> m_value;
@@ -133,6 +163,9 @@ protected:
 
 	InvertibleMap<YulString, YulString> m_storage;
 	InvertibleMap<YulString, YulString> m_memory;
+	/// m_keccakContents[x] contains the values of the memory words whose keccak256 hash
+	/// was assigned to x.
+	std::map<YulString, std::vector<YulString>> m_keccakContents;
 
 	KnowledgeBase m_knowledgeBase;
 
@@ -62,6 +62,23 @@ bool KnowledgeBase::knownToBeDifferentByAtLeast32(YulString _a, YulString _b)
 	return false;
 }
 
+boost::optional<u256> KnowledgeBase::valueIfKnownConstant(YulString _a)
+{
+	if (m_variableValues.count(_a))
+		if (Expression const* value = m_variableValues.at(_a))
+			if (value->type() == typeid(Literal))
+				return valueOfLiteral(boost::get<Literal>(*value));
+	return {};
+}
+
+boost::optional<u256> KnowledgeBase::differenceIfKnownConstant(YulString _a, YulString _b)
+{
+	Expression expr = simplify(FunctionCall{{}, {{}, "sub"_yulstring}, make_vector<Expression>(Identifier{{}, _a}, Identifier{{}, _b})});
+	if (expr.type() == typeid(Literal))
+		return valueOfLiteral(boost::get<Literal>(expr));
+	return {};
+}
+
 Expression KnowledgeBase::simplify(Expression _expression)
 {
 	bool startedRecursion = (m_recursionCounter == 0);
@@ -22,6 +22,10 @@
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/YulString.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/optional.hpp>
 #include <map>
 
 namespace yul
@@ -45,6 +49,10 @@ public:
 	bool knownToBeDifferent(YulString _a, YulString _b);
 	bool knownToBeDifferentByAtLeast32(YulString _a, YulString _b);
 	bool knownToBeEqual(YulString _a, YulString _b) const { return _a == _b; }
+	/// @returns the value of @a _a if it is known to be constant.
+	boost::optional<dev::u256> valueIfKnownConstant(YulString _a);
+	/// @returns the value of ``sub(_a, _b)`` if it is known to be constant.
+	boost::optional<dev::u256> differenceIfKnownConstant(YulString _a, YulString _b);
 
 private:
 	Expression simplify(Expression _expression);
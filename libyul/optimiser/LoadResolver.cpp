@@ -22,6 +22,7 @@
 #include <libyul/optimiser/LoadResolver.h>
 
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AsmData.h>
 
@@ -32,7 +33,11 @@ using namespace yul;
 void LoadResolver::run(Dialect const& _dialect, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_dialect, _ast);
-	LoadResolver{_dialect, !containsMSize}(_ast);
+	LoadResolver{
+		_dialect,
+		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast)),
+		!containsMSize
+	}(_ast);
 }
 
 void LoadResolver::visit(Expression& _e)
@@ -61,6 +66,17 @@ void LoadResolver::visit(Expression& _e)
 					_e = Identifier{locationOf(_e), m_memory.values[key]};
 					return;
 				}
+				else if (
+					m_optimizeMLoad &&
+					builtin->instruction == dev::eth::Instruction::KECCAK256
+				)
+					if (auto contents = keccakContents(_e))
+						for (auto const& item: m_keccakContents)
+							if (item.second == *contents)
+							{
+								_e = Identifier{locationOf(_e), item.first};
+								return;
+							}
 			}
 	}
 }
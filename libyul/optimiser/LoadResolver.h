@@ -31,6 +31,12 @@ struct EVMDialect;
 /**
  * Optimisation stage that replaces expressions of type ``sload(x)`` and ``mload(x)`` by the value
  * currently stored in storage resp. memory, if known.
+ * Also replaces ``keccak256(p, n)`` by a variable that was assigned the hash of the
+ * same memory contents before, as it happens for repeated accesses to a mapping.
+ *
+ * Calls to user-defined functions only invalidate the knowledge if they can modify
+ * storage resp. memory, so values are also resolved across calls and loops that
+ * only call such functions.
  *
  * Works best if the code is in SSA form.
  *
@@ -42,8 +48,12 @@ public:
 	static void run(Dialect const& _dialect, Block& _ast);
 
 private:
-	LoadResolver(Dialect const& _dialect, bool _optimizeMLoad):
-		DataFlowAnalyzer(_dialect),
+	LoadResolver(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _optimizeMLoad
+	):
+		DataFlowAnalyzer(_dialect, std::move(_functionSideEffects)),
 		m_optimizeMLoad(_optimizeMLoad)
 	{}
 
@@ -0,0 +1,200 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations in front of the loop.
+ */
+
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+#include <libyul/Exceptions.h>
+
+#include <libdevcore/CommonData.h>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void LoopInvariantCodeMotion::run(Dialect const& _dialect, Block& _ast)
+{
+	Assignments assignments;
+	assignments(_ast);
+	LoopInvariantCodeMotion{
+		_dialect,
+		assignments.names(),
+		SideEffectsPropagator::sideEffects(_dialect, CallGraphGenerator::callGraph(_ast)),
+		MSizeFinder::containsMSize(_dialect, _ast)
+	}(_ast);
+}
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(
+	Dialect const& _dialect,
+	set<YulString> _assignedVariables,
+	map<YulString, SideEffects> _functionSideEffects,
+	bool _containsMSize
+):
+	m_dialect(_dialect),
+	m_assignedVariables(std::move(_assignedVariables)),
+	m_functionSideEffects(std::move(_functionSideEffects)),
+	m_containsMSize(_containsMSize)
+{
+}
+
+void LoopInvariantCodeMotion::operator()(Block& _block)
+{
+	iterateReplacing(
+		_block.statements,
+		[&](Statement& _statement) -> boost::optional<vector<Statement>>
+		{
+			// Process inner loops first, so that their invariant declarations
+			// end up in this block and can be moved further.
+			visit(_statement);
+			if (_statement.type() == typeid(ForLoop))
+				return rewriteLoop(boost::get<ForLoop>(_statement));
+			return {};
+		}
+	);
+}
+
+boost::optional<vector<Statement>> LoopInvariantCodeMotion::rewriteLoop(ForLoop& _for)
+{
+	assertThrow(_for.pre.statements.empty(), OptimizerException, "");
+
+	SideEffectsCollector loopSideEffects{m_dialect, *_for.condition, &m_functionSideEffects};
+	loopSideEffects(_for.body);
+	loopSideEffects(_for.post);
+	SideEffects sideEffects;
+	sideEffects.invalidatesStorage = loopSideEffects.invalidatesStorage();
+	sideEffects.invalidatesMemory = loopSideEffects.invalidatesMemory();
+
+	// Determine the invariant declarations. Variables declared by them do not
+	// count as declared inside the loop, since they can be moved as well.
+	vector<VariableDeclaration const*> invariant;
+	set<YulString> varsDeclaredInLoop;
+	for (Block const* block: {&_for.body, &_for.post})
+		for (Statement const& statement: block->statements)
+			if (statement.type() == typeid(VariableDeclaration))
+			{
+				VariableDeclaration const& varDecl = boost::get<VariableDeclaration>(statement);
+				if (canBePromoted(varDecl, varsDeclaredInLoop, sideEffects))
+					invariant.emplace_back(&varDecl);
+				else
+					for (auto const& var: varDecl.variables)
+						varsDeclaredInLoop.insert(var.name);
+			}
+
+	// Moving declarations of literals or copies of variables does not save anything
+	// but increases the stack pressure, so they are only moved if a moved declaration
+	// references them.
+	set<VariableDeclaration const*> toMove;
+	set<YulString> referencedByMoved;
+	for (VariableDeclaration const* varDecl: invariant | boost::adaptors::reversed)
+	{
+		bool trivial =
+			!varDecl->value ||
+			varDecl->value->type() == typeid(Literal) ||
+			varDecl->value->type() == typeid(Identifier);
+		bool referenced = false;
+		for (auto const& var: varDecl->variables)
+			if (referencedByMoved.count(var.name))
+				referenced = true;
+		if (trivial && !referenced)
+			continue;
+		toMove.insert(varDecl);
+		if (varDecl->value)
+			referencedByMoved += MovableChecker{m_dialect, *varDecl->value}.referencedVariables();
+	}
+	if (toMove.empty())
+		return {};
+
+	vector<Statement> replacement;
+	for (Block* block: {&_for.body, &_for.post})
+		iterateReplacing(
+			block->statements,
+			[&](Statement& _statement) -> boost::optional<vector<Statement>>
+			{
+				if (
+					_statement.type() == typeid(VariableDeclaration) &&
+					toMove.count(&boost::get<VariableDeclaration>(_statement))
+				)
+				{
+					replacement.emplace_back(std::move(_statement));
+					return vector<Statement>{};
+				}
+				return {};
+			}
+		);
+	replacement.emplace_back(std::move(_for));
+	return {std::move(replacement)};
+}
+
+bool LoopInvariantCodeMotion::canBePromoted(
+	VariableDeclaration const& _varDecl,
+	set<YulString> const& _varsDeclaredInLoop,
+	SideEffects const& _loopSideEffects
+) const
+{
+	for (auto const& var: _varDecl.variables)
+		if (m_assignedVariables.count(var.name))
+			return false;
+	if (!_varDecl.value)
+		return true;
+
+	MovableChecker checker{m_dialect, *_varDecl.value, &m_functionSideEffects};
+	for (YulString name: checker.referencedVariables())
+		if (_varsDeclaredInLoop.count(name) || m_assignedVariables.count(name))
+			return false;
+	return checker.movable() || isInvariantLoad(*_varDecl.value, _loopSideEffects);
+}
+
+bool LoopInvariantCodeMotion::isInvariantLoad(
+	Expression const& _expression,
+	SideEffects const& _loopSideEffects
+) const
+{
+	if (_expression.type() != typeid(FunctionCall))
+		return false;
+	FunctionCall const& funCall = boost::get<FunctionCall>(_expression);
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&m_dialect);
+	if (!dialect)
+		return false;
+	BuiltinFunctionForEVM const* builtin = dialect->builtin(funCall.functionName.name);
+	if (!builtin || !builtin->instruction)
+		return false;
+
+	for (auto const& argument: funCall.arguments)
+		if (!MovableChecker{m_dialect, argument, &m_functionSideEffects}.movable())
+			return false;
+
+	switch (*builtin->instruction)
+	{
+	case dev::eth::Instruction::SLOAD:
+		return !_loopSideEffects.invalidatesStorage;
+	case dev::eth::Instruction::MLOAD:
+	case dev::eth::Instruction::KECCAK256:
+		// Moving memory accesses can change the memory size.
+		return !m_containsMSize && !_loopSideEffects.invalidatesMemory;
+	default:
+		return false;
+	}
+}
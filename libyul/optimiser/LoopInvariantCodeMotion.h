@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that moves loop-invariant variable declarations in front of the loop.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/SideEffects.h>
+#include <libyul/AsmData.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <set>
+
+namespace yul
+{
+struct Dialect;
+
+/**
+ * Optimisation stage that moves variable declarations out of the body and the post
+ * block of for loops and in front of the loop, if their value is the same in every
+ * iteration.
+ *
+ * A declaration ``let x := e`` is moved if
+ *  - ``x`` is never re-assigned,
+ *  - ``e`` only references variables that are never re-assigned and that are not
+ *    declared inside the loop (unless they were moved themselves) and
+ *  - ``e`` is movable, or ``e`` is ``sload(k)`` and the loop does not modify storage,
+ *    or ``e`` is ``mload(k)`` or ``keccak256(p, n)`` and the loop does not modify
+ *    memory (and the code does not use ``msize``).
+ *
+ * Declarations of literals or copies of other variables are only moved if another
+ * moved declaration references them, since moving them alone only increases the
+ * stack pressure.
+ *
+ * Side-effects of user-defined functions are taken into account.
+ * Since inner loops are processed first, declarations can be moved out
+ * of nested loops step by step.
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class LoopInvariantCodeMotion: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	LoopInvariantCodeMotion(
+		Dialect const& _dialect,
+		std::set<YulString> _assignedVariables,
+		std::map<YulString, SideEffects> _functionSideEffects,
+		bool _containsMSize
+	);
+
+	/// @returns the moved declarations followed by the loop or nothing if
+	/// no declaration can be moved.
+	boost::optional<std::vector<Statement>> rewriteLoop(ForLoop& _for);
+	/// @returns true if the declaration can be moved in front of the loop.
+	/// @param _varsDeclaredInLoop variables declared in the loop in front of the declaration.
+	/// @param _loopSideEffects side-effects of the condition, body and post block of the loop.
+	bool canBePromoted(
+		VariableDeclaration const& _varDecl,
+		std::set<YulString> const& _varsDeclaredInLoop,
+		SideEffects const& _loopSideEffects
+	) const;
+	/// @returns true if the expression is a load from storage or memory (or a hash of memory)
+	/// with movable arguments and the loop does not modify the respective location.
+	bool isInvariantLoad(Expression const& _expression, SideEffects const& _loopSideEffects) const;
+
+	Dialect const& m_dialect;
+	std::set<YulString> m_assignedVariables;
+	std::map<YulString, SideEffects> m_functionSideEffects;
+	bool m_containsMSize = true;
+};
+
+}
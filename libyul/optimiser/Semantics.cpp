@@ -35,8 +35,12 @@ using namespace dev;
 using namespace yul;
 
 
-SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Expression const& _expression):
-	SideEffectsCollector(_dialect)
+SideEffectsCollector::SideEffectsCollector(
+	Dialect const& _dialect,
+	Expression const& _expression,
+	map<YulString, SideEffects> const* _functionSideEffects
+):
+	SideEffectsCollector(_dialect, _functionSideEffects)
 {
 	visit(_expression);
 }
@@ -47,8 +51,12 @@ SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Statement co
 	visit(_statement);
 }
 
-SideEffectsCollector::SideEffectsCollector(Dialect const& _dialect, Block const& _ast):
-	SideEffectsCollector(_dialect)
+SideEffectsCollector::SideEffectsCollector(
+	Dialect const& _dialect,
+	Block const& _ast,
+	map<YulString, SideEffects> const* _functionSideEffects
+):
+	SideEffectsCollector(_dialect, _functionSideEffects)
 {
 	operator()(_ast);
 }
@@ -66,6 +74,8 @@ void SideEffectsCollector::operator()(FunctionCall const& _functionCall)
 
 	if (BuiltinFunction const* f = m_dialect.builtin(_functionCall.functionName.name))
 		m_sideEffects += f->sideEffects;
+	else if (m_functionSideEffects && m_functionSideEffects->count(_functionCall.functionName.name))
+		m_sideEffects += m_functionSideEffects->at(_functionCall.functionName.name);
 	else
 		m_sideEffects += SideEffects::worst();
 }
@@ -121,8 +131,20 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	return ret;
 }
 
-MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
-	MovableChecker(_dialect)
+MovableChecker::MovableChecker(
+	Dialect const& _dialect,
+	map<YulString, SideEffects> const* _functionSideEffects
+):
+	SideEffectsCollector(_dialect, _functionSideEffects)
+{
+}
+
+MovableChecker::MovableChecker(
+	Dialect const& _dialect,
+	Expression const& _expression,
+	map<YulString, SideEffects> const* _functionSideEffects
+):
+	MovableChecker(_dialect, _functionSideEffects)
 {
 	visit(_expression);
 }
@@ -23,6 +23,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/SideEffects.h>
 
+#include <map>
 #include <set>
 
 namespace yul
@@ -32,14 +33,28 @@ struct Dialect;
 /**
  * Specific AST walker that determines side-effect free-ness and movability of code.
  * Enters into function definitions.
+ *
+ * Calls to user-defined functions are assumed to have the worst side effects,
+ * unless their side effects are provided (see SideEffectsPropagator).
  */
 class SideEffectsCollector: public ASTWalker
 {
 public:
-	explicit SideEffectsCollector(Dialect const& _dialect): m_dialect(_dialect) {}
-	SideEffectsCollector(Dialect const& _dialect, Expression const& _expression);
+	explicit SideEffectsCollector(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+	): m_dialect(_dialect), m_functionSideEffects(_functionSideEffects) {}
+	SideEffectsCollector(
+		Dialect const& _dialect,
+		Expression const& _expression,
+		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+	);
 	SideEffectsCollector(Dialect const& _dialect, Statement const& _statement);
-	SideEffectsCollector(Dialect const& _dialect, Block const& _ast);
+	SideEffectsCollector(
+		Dialect const& _dialect,
+		Block const& _ast,
+		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+	);
 
 	using ASTWalker::operator();
 	void operator()(FunctionalInstruction const& _functionalInstruction) override;
@@ -59,6 +74,7 @@ public:
 
 private:
 	Dialect const& m_dialect;
+	std::map<YulString, SideEffects> const* m_functionSideEffects = nullptr;
 	SideEffects m_sideEffects;
 };
 
@@ -108,8 +124,15 @@ private:
 class MovableChecker: public SideEffectsCollector
 {
 public:
-	explicit MovableChecker(Dialect const& _dialect): SideEffectsCollector(_dialect) {}
-	MovableChecker(Dialect const& _dialect, Expression const& _expression);
+	explicit MovableChecker(
+		Dialect const& _dialect,
+		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+	);
+	MovableChecker(
+		Dialect const& _dialect,
+		Expression const& _expression,
+		std::map<YulString, SideEffects> const* _functionSideEffects = nullptr
+	);
 
 	void operator()(Identifier const& _identifier) override;
 
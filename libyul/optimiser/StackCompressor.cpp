@@ -166,9 +166,21 @@ bool StackCompressor::run(
 		"Need to run the function grouper before the stack compressor."
 	);
 	bool allowMSizeOptimzation = !MSizeFinder::containsMSize(_dialect, *_object.code);
+	map<YulString, int> stackSurplus;
 	for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 	{
-		map<YulString, int> stackSurplus = CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation);
+		// An error in the outermost block stops the check before the functions are reached.
+		if (iterations == 0 || stackSurplus.count({}))
+			stackSurplus = CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation);
+		else
+		{
+			// Only the functions that had a stack surplus were modified,
+			// so the others do not have to be checked again.
+			set<YulString> modifiedFunctions;
+			for (auto const& surplus: stackSurplus)
+				modifiedFunctions.insert(surplus.first);
+			stackSurplus = CompilabilityChecker::run(_dialect, _object, _optimizeStackAllocation, modifiedFunctions);
+		}
 		if (stackSurplus.empty())
 			return true;
 
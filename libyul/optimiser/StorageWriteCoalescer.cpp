@@ -0,0 +1,203 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes storage writes that are overwritten later
+ * in the same block.
+ */
+
+#include <libyul/optimiser/StorageWriteCoalescer.h>
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AsmData.h>
+
+#include <libdevcore/Algorithms.h>
+#include <libdevcore/CommonData.h>
+
+using namespace std;
+using namespace dev;
+using namespace yul;
+
+void StorageWriteCoalescer::run(Dialect const& _dialect, Block& _ast)
+{
+	EVMDialect const* dialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	if (!dialect)
+		return;
+
+	SSAValueTracker ssaValues;
+	ssaValues(_ast);
+	StorageWriteCoalescer{
+		*dialect,
+		ssaValues.values(),
+		storageObservingFunctions(*dialect, CallGraphGenerator::callGraph(_ast))
+	}(_ast);
+}
+
+StorageWriteCoalescer::StorageWriteCoalescer(
+	EVMDialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues,
+	set<YulString> _storageObservingFunctions
+):
+	m_dialect(_dialect),
+	m_knowledgeBase(_dialect, _ssaValues),
+	m_storageObservingFunctions(std::move(_storageObservingFunctions))
+{
+}
+
+set<YulString> StorageWriteCoalescer::storageObservingFunctions(
+	EVMDialect const& _dialect,
+	map<YulString, set<YulString>> const& _callGraph
+)
+{
+	set<YulString> result;
+	for (auto const& call: _callGraph)
+	{
+		bool observes = false;
+		BreadthFirstSearch<YulString>{call.second, {call.first}}.run(
+			[&](YulString _function, auto&& _addChild) {
+				if (observes)
+					return;
+				if (BuiltinFunctionForEVM const* builtin = _dialect.builtin(_function))
+					observes = observesStorage(*builtin);
+				else if (_callGraph.count(_function))
+					for (YulString callee: _callGraph.at(_function))
+						_addChild(callee);
+				else
+					observes = true;
+			}
+		);
+		if (observes)
+			result.insert(call.first);
+	}
+	return result;
+}
+
+bool StorageWriteCoalescer::observesStorage(BuiltinFunctionForEVM const& _builtin)
+{
+	if (!_builtin.instruction)
+		return false;
+	switch (*_builtin.instruction)
+	{
+	case dev::eth::Instruction::SLOAD:
+	// Calls and contract creation can read storage via re-entrancy.
+	case dev::eth::Instruction::CALL:
+	case dev::eth::Instruction::CALLCODE:
+	case dev::eth::Instruction::DELEGATECALL:
+	case dev::eth::Instruction::STATICCALL:
+	case dev::eth::Instruction::CREATE:
+	case dev::eth::Instruction::CREATE2:
+	// These end the execution without reverting.
+	case dev::eth::Instruction::RETURN:
+	case dev::eth::Instruction::STOP:
+	case dev::eth::Instruction::SELFDESTRUCT:
+		return true;
+	default:
+		return false;
+	}
+}
+
+void StorageWriteCoalescer::operator()(Block& _block)
+{
+	ASTModifier::operator()(_block);
+
+	vector<Statement>& statements = _block.statements;
+	vector<bool> overwritten(statements.size(), false);
+	for (size_t i = 0; i < statements.size(); ++i)
+		if (boost::optional<YulString> key = storeKey(statements[i]))
+			for (size_t j = i + 1; j < statements.size(); ++j)
+				if (storeKey(statements[j]) == key)
+				{
+					overwritten[i] = true;
+					break;
+				}
+				else if (!independentOf(statements[j], *key))
+					break;
+
+	size_t index = 0;
+	iterateReplacing(statements, [&](Statement&) -> boost::optional<vector<Statement>> {
+		if (overwritten[index++])
+			return vector<Statement>{};
+		return {};
+	});
+}
+
+boost::optional<YulString> StorageWriteCoalescer::storeKey(Statement const& _statement) const
+{
+	if (_statement.type() != typeid(ExpressionStatement))
+		return {};
+	Expression const& expression = boost::get<ExpressionStatement>(_statement).expression;
+	if (expression.type() != typeid(FunctionCall))
+		return {};
+	FunctionCall const& funCall = boost::get<FunctionCall>(expression);
+	if (auto const* builtin = m_dialect.builtin(funCall.functionName.name))
+		if (
+			builtin->instruction == dev::eth::Instruction::SSTORE &&
+			funCall.arguments.at(0).type() == typeid(Identifier) &&
+			funCall.arguments.at(1).type() == typeid(Identifier)
+		)
+			return boost::get<Identifier>(funCall.arguments.at(0)).name;
+	return {};
+}
+
+bool StorageWriteCoalescer::independentOf(Statement const& _statement, YulString _key)
+{
+	if (_statement.type() == typeid(ExpressionStatement))
+		return independentOf(boost::get<ExpressionStatement>(_statement).expression, _key);
+	else if (_statement.type() == typeid(VariableDeclaration))
+	{
+		VariableDeclaration const& varDecl = boost::get<VariableDeclaration>(_statement);
+		return !varDecl.value || independentOf(*varDecl.value, _key);
+	}
+	else if (_statement.type() == typeid(Assignment))
+	{
+		Assignment const& assignment = boost::get<Assignment>(_statement);
+		for (auto const& var: assignment.variableNames)
+			if (var.name == _key)
+				return false;
+		return independentOf(*assignment.value, _key);
+	}
+	else
+		return false;
+}
+
+bool StorageWriteCoalescer::independentOf(Expression const& _expression, YulString _key)
+{
+	if (_expression.type() != typeid(FunctionCall))
+		return true;
+
+	FunctionCall const& funCall = boost::get<FunctionCall>(_expression);
+	if (BuiltinFunctionForEVM const* builtin = m_dialect.builtin(funCall.functionName.name))
+	{
+		if (builtin->instruction == dev::eth::Instruction::SLOAD)
+		{
+			if (
+				funCall.arguments.at(0).type() != typeid(Identifier) ||
+				!m_knowledgeBase.knownToBeDifferent(boost::get<Identifier>(funCall.arguments.at(0)).name, _key)
+			)
+				return false;
+		}
+		else if (observesStorage(*builtin))
+			return false;
+	}
+	else if (m_storageObservingFunctions.count(funCall.functionName.name))
+		return false;
+	for (auto const& argument: funCall.arguments)
+		if (!independentOf(argument, _key))
+			return false;
+	return true;
+}
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimisation stage that removes storage writes that are overwritten later
+ * in the same block.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/KnowledgeBase.h>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <set>
+
+namespace yul
+{
+struct Dialect;
+struct EVMDialect;
+struct BuiltinFunctionForEVM;
+
+/**
+ * Optimisation stage that removes statements of the form ``sstore(k, v)`` if they are
+ * followed by ``sstore(k, w)`` in the same block and the statements in between
+ * cannot read the storage slot ``k`` and cannot end the execution without reverting.
+ *
+ * Together with the LoadResolver, which replaces ``sload(k)`` by the value
+ * stored at ``k`` if known, this coalesces multiple read-modify-write sequences
+ * on the same storage slot (e.g. updates of several members that are packed
+ * into one slot) into a single ``sload`` and a single ``sstore``.
+ *
+ * Only expression statements, variable declarations and assignments are considered
+ * in between the two writes. They can call user-defined functions as long as these
+ * (and all functions they call) do not read storage or end the execution without
+ * reverting.
+ *
+ * Works best if the code is in SSA form.
+ *
+ * Prerequisite: Disambiguator, ExpressionSplitter.
+ */
+class StorageWriteCoalescer: public ASTModifier
+{
+public:
+	static void run(Dialect const& _dialect, Block& _ast);
+
+	using ASTModifier::operator();
+	void operator()(Block& _block) override;
+
+private:
+	StorageWriteCoalescer(
+		EVMDialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues,
+		std::set<YulString> _storageObservingFunctions
+	);
+
+	/// @returns the set of user-defined functions that can (directly or indirectly) read
+	/// storage or end the execution without reverting.
+	static std::set<YulString> storageObservingFunctions(
+		EVMDialect const& _dialect,
+		std::map<YulString, std::set<YulString>> const& _callGraph
+	);
+	/// @returns true if the builtin can read storage (at any slot) or end the execution
+	/// without reverting.
+	static bool observesStorage(BuiltinFunctionForEVM const& _builtin);
+
+	/// @returns the key of the statement if it is of the form ``sstore(k, v)`` with
+	/// identifiers ``k`` and ``v``.
+	boost::optional<YulString> storeKey(Statement const& _statement) const;
+	/// @returns true if the statement cannot read storage at @a _key, does not assign
+	/// to @a _key and cannot leave the block other than by reverting.
+	bool independentOf(Statement const& _statement, YulString _key);
+	bool independentOf(Expression const& _expression, YulString _key);
+
+	EVMDialect const& m_dialect;
+	KnowledgeBase m_knowledgeBase;
+	std::set<YulString> m_storageObservingFunctions;
+};
+
+}
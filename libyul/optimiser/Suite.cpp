@@ -33,6 +33,8 @@
 #include <libyul/optimiser/ExpressionInliner.h>
 #include <libyul/optimiser/FullInliner.h>
 #include <libyul/optimiser/ForLoopInitRewriter.h>
+#include <libyul/optimiser/LoadResolver.h>
+#include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Rematerialiser.h>
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/ExpressionSimplifier.h>
@@ -40,6 +42,7 @@
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StorageWriteCoalescer.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
 #include <libyul/optimiser/VarNameCleaner.h>
@@ -115,6 +118,9 @@ void OptimiserSuite::run(
 
 			ExpressionSimplifier::run(_dialect, ast);
 			CommonSubexpressionEliminator{_dialect}(ast);
+			LoadResolver::run(_dialect, ast);
+			StorageWriteCoalescer::run(_dialect, ast);
+			LoopInvariantCodeMotion::run(_dialect, ast);
 		}
 
 		{
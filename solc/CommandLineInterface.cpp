@@ -28,11 +28,14 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/parsing/Parser.h>
 #include <libsolidity/ast/ASTPrinter.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
+#include <libsolidity/formal/SMTQueryCache.h>
+#include <libsolidity/formal/SMTSolverProcessPool.h>
 
 #include <libyul/AssemblyStack.h>
 
@@ -66,6 +69,8 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <thread>
 
 #if !defined(STDERR_FILENO)
 	#define STDERR_FILENO 2
@@ -107,6 +112,7 @@ static string const g_strAssemble = "assemble";
 static string const g_strAst = "ast";
 static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
+static string const g_strAstBinary = "ast-binary";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
@@ -136,9 +142,21 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOptimizeSuper = "optimize-super";
+static string const g_strOptimizeProfile = "optimize-profile";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strSignatureHashes = "hashes";
+static string const g_strSMTAsync = "smt-async";
+static string const g_strSMTCache = "smt-cache";
+static string const g_strSMTFunctionSummaries = "smt-function-summaries";
+static string const g_strSMTSolver = "smt-solver";
+static string const g_strSMTResourceLimit = "smt-resource-limit";
+static string const g_strSMTSolverProcesses = "smt-solver-processes";
+static string const g_strSMTTelemetry = "smt-telemetry";
+static string const g_strSMTThreads = "smt-threads";
+static string const g_strSMTTimeout = "smt-timeout";
+static string const g_strSMTTotalTimeout = "smt-total-timeout";
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
 static string const g_strSrcMap = "srcmap";
@@ -160,6 +178,7 @@ static string const g_argAsmJson = g_strAsmJson;
 static string const g_argAssemble = g_strAssemble;
 static string const g_argAst = g_strAst;
 static string const g_argAstCompactJson = g_strAstCompactJson;
+static string const g_argAstBinary = g_strAstBinary;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
@@ -651,7 +670,71 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_strOptimizeSuper.c_str(),
+			"Enable search for cheaper replacements of short instruction sequences in the bytecode optimizer. "
+			"Can considerably increase the compilation time."
+		)
+		(
+			g_strOptimizeProfile.c_str(),
+			po::value<string>()->value_name("file"),
+			"JSON file with an execution profile, i.e. an object mapping function signatures to their number of calls. "
+			"Frequently called functions are checked first in the function selector."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
+		(
+			g_strSMTAsync.c_str(),
+			"Generate the code while the SMTChecker is still analyzing the contracts."
+		)
+		(
+			g_strSMTCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory in which the SMTChecker stores the results of its queries. "
+			"The results are reused in later runs if the same queries come up again."
+		)
+		(
+			g_strSMTFunctionSummaries.c_str(),
+			"Let the SMTChecker abstract internal calls to pure functions by uninterpreted functions of the arguments "
+			"instead of inlining the called function at every call site. "
+			"This bounds the size of the queries but the return values of such calls are unknown."
+		)
+		(
+			g_strSMTSolver.c_str(),
+			po::value<string>()->value_name("command"),
+			"Command that starts an SMT solver reading SMT-LIB2 queries from its standard input, e.g. \"z3 -in\". "
+			"The SMTChecker sends the queries it cannot answer with an integrated solver to such processes."
+		)
+		(
+			g_strSMTSolverProcesses.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Maximum number of SMT solver processes started with --smt-solver. Defaults to the number of hardware threads."
+		)
+		(
+			g_strSMTTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms")->default_value(ModelCheckerSettings{}.solverLimits.timeout),
+			"Timeout in milliseconds for each query of the SMTChecker (0 for no timeout)."
+		)
+		(
+			g_strSMTTotalTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms")->default_value(0),
+			"Timeout in milliseconds for the whole analysis of the SMTChecker (0 for no timeout). "
+			"Queries after the timeout are not checked."
+		)
+		(
+			g_strSMTResourceLimit.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(0),
+			"Resource limit (Z3's rlimit) for each query of the SMTChecker (0 for no limit). "
+			"Unlike the timeout, it gives the same results on all machines."
+		)
+		(
+			g_strSMTTelemetry.c_str(),
+			"Print the target, source location, result and duration of each solver for each query of the SMTChecker."
+		)
+		(
+			g_strSMTThreads.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(0),
+			"Maximum number of contracts the SMTChecker analyzes concurrently (0 for the number of hardware threads)."
+		)
 		(
 			g_argLibraries.c_str(),
 			po::value<vector<string>>()->value_name("libs"),
@@ -714,6 +797,7 @@ Allowed options)",
 		(g_argAst.c_str(), "AST of all source files.")
 		(g_argAstJson.c_str(), "AST of all source files in JSON format.")
 		(g_argAstCompactJson.c_str(), "AST of all source files in a compact JSON format.")
+		(g_argAstBinary.c_str(), "AST of all source files in a compact binary format (hex encoded unless --output-dir is used).")
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -854,8 +938,11 @@ bool CommandLineInterface::processInput()
 	{
 		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
-		return true;
+		bool success = compiler.compile(input, sout());
+		sout() << endl;
+		if (!success)
+			serr() << "Internal error while writing the compiler output." << endl;
+		return success;
 	}
 
 	if (!readInputFilesAndConfigureRemappings())
@@ -954,10 +1041,97 @@ bool CommandLineInterface::processInput()
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
+		settings.runSuperOptimiser = m_args.count(g_strOptimizeSuper);
+		if (m_args.count(g_strOptimizeProfile))
+		{
+			string profileFile = m_args[g_strOptimizeProfile].as<string>();
+			Json::Value profile;
+			bool valid = jsonParseStrict(readFileAsString(profileFile), profile) && profile.isObject();
+			if (valid)
+			{
+				for (auto const& signature: profile.getMemberNames())
+					if (profile[signature].isUInt())
+						settings.functionCallCounts[signature] = profile[signature].asUInt();
+					else
+						valid = false;
+			}
+			if (!valid)
+			{
+				serr() <<
+					"Invalid execution profile \"" << profileFile << "\": " <<
+					"Expected an object mapping function signatures to numbers of calls." << endl;
+				return false;
+			}
+		}
 		m_compiler->setOptimiserSettings(settings);
 
+		shared_ptr<smt::SMTQueryCache> smtQueryCache;
+		if (m_args.count(g_strSMTCache))
+		{
+			smtQueryCache = make_shared<smt::SMTQueryCache>(m_args[g_strSMTCache].as<string>());
+			m_compiler->setSMTQueryCache(smtQueryCache);
+		}
+		if (m_args.count(g_strSMTSolver))
+		{
+			string command = boost::trim_copy(m_args[g_strSMTSolver].as<string>());
+			if (command.empty())
+			{
+				serr() << "Invalid SMT solver command: Expected a command." << endl;
+				return false;
+			}
+			size_t processes = thread::hardware_concurrency();
+			if (m_args.count(g_strSMTSolverProcesses))
+				processes = m_args[g_strSMTSolverProcesses].as<unsigned>();
+			auto solverPool = make_shared<smt::SMTSolverProcessPool>(
+				command,
+				processes,
+				chrono::milliseconds(m_args[g_strSMTTimeout].as<unsigned>())
+			);
+			m_compiler->setSMTCallback([solverPool](string const& _query) { return solverPool->query(_query); });
+		}
+		ModelCheckerSettings modelCheckerSettings;
+		modelCheckerSettings.solverLimits.timeout = m_args[g_strSMTTimeout].as<unsigned>();
+		modelCheckerSettings.solverLimits.resourceLimit = m_args[g_strSMTResourceLimit].as<unsigned>();
+		modelCheckerSettings.totalTimeout = m_args[g_strSMTTotalTimeout].as<unsigned>();
+		modelCheckerSettings.functionSummaries = m_args.count(g_strSMTFunctionSummaries);
+		modelCheckerSettings.threads = m_args[g_strSMTThreads].as<unsigned>();
+		modelCheckerSettings.asynchronous = m_args.count(g_strSMTAsync);
+		m_compiler->setModelCheckerSettings(modelCheckerSettings);
+
 		bool successful = m_compiler->compile();
 
+		if (smtQueryCache)
+			serr() <<
+				"SMT query cache: " <<
+				smtQueryCache->hits() << " hits, " <<
+				smtQueryCache->misses() << " misses." << endl;
+		if (m_args.count(g_strSMTTelemetry))
+			for (QueryTelemetry const& query: m_compiler->smtQueryTelemetry())
+			{
+				serr() << "SMT query: ";
+				if (query.location.source)
+				{
+					int line;
+					int column;
+					tie(line, column) = query.location.source->translatePositionToLineColumn(query.location.start);
+					serr() << query.location.source->name() << ":" << (line + 1) << ":" << (column + 1) << ": ";
+				}
+				serr() <<
+					query.target << ": " <<
+					smt::checkResultName(query.result) << " in " <<
+					query.duration.count() << " ms";
+				if (query.solvers.empty())
+					serr() << " (skipped)";
+				else
+				{
+					vector<string> runs;
+					for (smt::SolverRun const& run: query.solvers)
+						runs.push_back(run.solver + ": " + smt::checkResultName(run.result) + " in " + to_string(run.duration.count()) + " ms");
+					serr() << " (" << boost::algorithm::join(runs, ", ") << ")";
+				}
+				serr() << endl;
+			}
+
 		for (auto const& error: m_compiler->errors())
 		{
 			g_hasOutput = true;
@@ -1032,18 +1206,23 @@ void CommandLineInterface::handleCombinedJSON()
 	if (!m_args.count(g_argCombinedJson))
 		return;
 
-	Json::Value output(Json::objectValue);
+	// Compact output to stdout is streamed contract by contract and source by source,
+	// everything else is collected first.
+	bool const streamOutput = !m_args.count(g_argPrettyJson) && !m_args.count(g_argOutputDir);
+	Json::Value output;
+	unique_ptr<JsonWriter> writer = streamOutput ? make_unique<JsonWriter>(sout()) : make_unique<JsonWriter>(output);
 
-	output[g_strVersion] = ::dev::solidity::VersionString;
 	set<string> requests;
 	boost::split(requests, m_args[g_argCombinedJson].as<string>(), boost::is_any_of(","));
 	vector<string> contracts = m_compiler->contractNames();
 
+	// Members are written in sorted key order.
+	writer->beginObject();
 	if (!contracts.empty())
-		output[g_strContracts] = Json::Value(Json::objectValue);
+		writer->beginObject(g_strContracts);
 	for (string const& contractName: contracts)
 	{
-		Json::Value& contractData = output[g_strContracts][contractName] = Json::objectValue;
+		Json::Value contractData = Json::objectValue;
 		if (requests.count(g_strAbi))
 			contractData[g_strAbi] = dev::jsonCompactPrint(m_compiler->contractABI(contractName));
 		if (requests.count("metadata"))
@@ -1072,36 +1251,49 @@ void CommandLineInterface::handleCombinedJSON()
 			contractData[g_strNatspecDev] = dev::jsonCompactPrint(m_compiler->natspecDev(contractName));
 		if (requests.count(g_strNatspecUser))
 			contractData[g_strNatspecUser] = dev::jsonCompactPrint(m_compiler->natspecUser(contractName));
+		writer->write(contractName, std::move(contractData));
 	}
+	if (!contracts.empty())
+		writer->endObject();
 
 	bool needsSourceList = requests.count(g_strAst) || requests.count(g_strSrcMap) || requests.count(g_strSrcMapRuntime);
 	if (needsSourceList)
 	{
 		// Indices into this array are used to abbreviate source names in source locations.
-		output[g_strSourceList] = Json::Value(Json::arrayValue);
-
+		Json::Value sourceList = Json::arrayValue;
 		for (auto const& source: m_compiler->sourceNames())
-			output[g_strSourceList].append(source);
+			sourceList.append(source);
+		writer->write(g_strSourceList, std::move(sourceList));
 	}
 
 	if (requests.count(g_strAst))
 	{
 		bool legacyFormat = !requests.count(g_strCompactJSON);
-		output[g_strSources] = Json::Value(Json::objectValue);
+		writer->beginObject(g_strSources);
 		for (auto const& sourceCode: m_sourceCodes)
 		{
 			ASTJsonConverter converter(legacyFormat, m_compiler->sourceIndices());
-			output[g_strSources][sourceCode.first] = Json::Value(Json::objectValue);
-			output[g_strSources][sourceCode.first]["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			Json::Value sourceData = Json::objectValue;
+			sourceData["AST"] = converter.toJson(m_compiler->ast(sourceCode.first));
+			writer->write(sourceCode.first, std::move(sourceData));
 		}
+		writer->endObject();
 	}
 
-	string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(output) : dev::jsonCompactPrint(output);
+	writer->write(g_strVersion, ::dev::solidity::VersionString);
+	writer->endObject();
 
-	if (m_args.count(g_argOutputDir))
-		createJson("combined", json);
+	if (streamOutput)
+		sout() << endl;
 	else
-		sout() << json << endl;
+	{
+		string json = m_args.count(g_argPrettyJson) ? dev::jsonPrettyPrint(output) : dev::jsonCompactPrint(output);
+
+		if (m_args.count(g_argOutputDir))
+			createJson("combined", json);
+		else
+			sout() << json << endl;
+	}
 }
 
 void CommandLineInterface::handleAst(string const& _argStr)
@@ -1114,6 +1306,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 		title = "JSON AST:";
 	else if (_argStr == g_argAstCompactJson)
 		title = "JSON AST (compact format):";
+	else if (_argStr == g_argAstBinary)
+		title = "Binary AST (hex encoded):";
 	else
 		BOOST_THROW_EXCEPTION(InternalCompilerError() << errinfo_comment("Illegal argStr for AST"));
 
@@ -1148,6 +1342,11 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					ASTPrinter printer(m_compiler->ast(sourceCode.first), sourceCode.second);
 					printer.print(data);
 				}
+				else if (_argStr == g_argAstBinary)
+				{
+					data << asString(ASTBinaryConverter(m_compiler->sourceIndices()).toBinary(m_compiler->ast(sourceCode.first)));
+					postfix += "_bin";
+				}
 				else
 				{
 					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(data, m_compiler->ast(sourceCode.first));
@@ -1172,6 +1371,8 @@ void CommandLineInterface::handleAst(string const& _argStr)
 					);
 					printer.print(sout());
 				}
+				else if (_argStr == g_argAstBinary)
+					sout() << toHex(ASTBinaryConverter(m_compiler->sourceIndices()).toBinary(m_compiler->ast(sourceCode.first))) << endl;
 				else
 					ASTJsonConverter(legacyFormat, m_compiler->sourceIndices()).print(sout(), m_compiler->ast(sourceCode.first));
 			}
@@ -1401,6 +1602,7 @@ void CommandLineInterface::outputCompilationResults()
 	handleAst(g_argAst);
 	handleAst(g_argAstJson);
 	handleAst(g_argAstCompactJson);
+	handleAst(g_argAstBinary);
 
 	if (!m_compiler->compilationSuccessful())
 	{
@@ -21,6 +21,8 @@
 
 #include <test/EVMHost.h>
 
+#include <test/EVMInterpreter.h>
+
 #include <test/evmc/helpers.hpp>
 #include <test/evmc/loader.h>
 
@@ -50,9 +52,11 @@ evmc::vm* EVMHost::getVM(string const& _path)
 			cerr << "Error loading VM from " << _path;
 			if (char const* errorMsg = evmc_last_error_msg())
 				cerr << ":" << endl << errorMsg;
-			cerr << endl;
+			cerr << endl << "Using the built-in EVM interpreter instead." << endl;
 		}
 	}
+	if (!theVM)
+		theVM = make_unique<evmc::vm>(createEVMInterpreter());
 	return theVM.get();
 }
 
@@ -29,6 +29,8 @@
 
 #include <libdevcore/FixedHash.h>
 
+#include <unordered_map>
+
 namespace dev
 {
 namespace test
@@ -38,9 +40,9 @@ using Address = h160;
 class EVMHost: public evmc::Host
 {
 public:
-	/// Tries to dynamically load libevmone. @returns nullptr on failure.
-	/// The path has to be provided for the first successful run and will be ignored
-	/// afterwards.
+	/// Tries to dynamically load libevmone from @a _path and falls back to the
+	/// built-in EVM interpreter if the path is empty or loading fails.
+	/// The VM is selected on the first call, the path is ignored afterwards.
 	static evmc::vm* getVM(std::string const& _path = {});
 
 	explicit EVMHost(langutil::EVMVersion _evmVersion, evmc::vm* _vm = getVM());
@@ -51,7 +53,7 @@ public:
 		size_t nonce = 0;
 		bytes code;
 		evmc_bytes32 codeHash = {};
-		std::map<evmc_bytes32, evmc_bytes32> storage;
+		std::unordered_map<evmc_bytes32, evmc_bytes32> storage;
 	};
 
 	struct LogEntry
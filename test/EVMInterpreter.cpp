@@ -0,0 +1,961 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Built-in EVM bytecode interpreter, used to run the semantic tests
+ * if no external VM is available.
+ */
+
+#include <test/EVMInterpreter.h>
+
+#include <test/evmc/evmc.hpp>
+#include <test/evmc/helpers.hpp>
+
+#include <libevmasm/GasMeter.h>
+#include <libevmasm/Instruction.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libdevcore/CommonData.h>
+#include <libdevcore/Keccak256.h>
+
+#include <array>
+#include <cstring>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+/// Memory offsets and sizes from this value on always run out of gas.
+u256 const c_memoryLimit = u256(1) << 32;
+int32_t const c_maxCallDepth = 1024;
+
+/// Thrown to abort the execution of a message.
+struct ExecutionFailure
+{
+	evmc_status_code status;
+};
+
+langutil::EVMVersion toEVMVersion(evmc_revision _revision)
+{
+	switch (_revision)
+	{
+	case EVMC_FRONTIER:
+	case EVMC_HOMESTEAD:
+		return langutil::EVMVersion::homestead();
+	case EVMC_TANGERINE_WHISTLE:
+		return langutil::EVMVersion::tangerineWhistle();
+	case EVMC_SPURIOUS_DRAGON:
+		return langutil::EVMVersion::spuriousDragon();
+	case EVMC_BYZANTIUM:
+		return langutil::EVMVersion::byzantium();
+	case EVMC_CONSTANTINOPLE:
+		return langutil::EVMVersion::constantinople();
+	default:
+		return langutil::EVMVersion::petersburg();
+	}
+}
+
+/// @returns the gas costs of @a _instruction that do not depend on its arguments.
+int64_t staticGas(Instruction _instruction, langutil::EVMVersion _evmVersion)
+{
+	switch (_instruction)
+	{
+	case Instruction::EXP:
+		return GasCosts::expGas;
+	case Instruction::KECCAK256:
+		return GasCosts::keccak256Gas;
+	case Instruction::BALANCE:
+	case Instruction::EXTCODEHASH:
+		return GasCosts::balanceGas(_evmVersion);
+	case Instruction::EXTCODESIZE:
+	case Instruction::EXTCODECOPY:
+		return GasCosts::extCodeGas(_evmVersion);
+	case Instruction::SLOAD:
+		return GasCosts::sloadGas(_evmVersion);
+	case Instruction::SSTORE:
+		return 0;
+	case Instruction::JUMPDEST:
+		return GasCosts::jumpdestGas;
+	case Instruction::CREATE:
+	case Instruction::CREATE2:
+		return GasCosts::createGas;
+	case Instruction::CALL:
+	case Instruction::CALLCODE:
+	case Instruction::DELEGATECALL:
+	case Instruction::STATICCALL:
+		return GasCosts::callGas(_evmVersion);
+	case Instruction::SELFDESTRUCT:
+		return GasCosts::selfdestructGas(_evmVersion);
+	default:
+		if (isLogInstruction(_instruction))
+			return GasCosts::logGas + GasCosts::logTopicGas * getLogNumber(_instruction);
+		return GasMeter::runGas(_instruction);
+	}
+}
+
+/// Properties of all opcodes for a certain EVM revision, so that they
+/// do not have to be looked up during execution.
+struct InstructionTable
+{
+	langutil::EVMVersion evmVersion;
+	/// Static gas costs of each opcode, negative if the opcode is not defined.
+	array<int64_t, 256> gas;
+	/// Number of stack items consumed by each opcode.
+	array<size_t, 256> args;
+	/// Number of stack items produced by each opcode.
+	array<size_t, 256> ret;
+};
+
+InstructionTable makeInstructionTable(evmc_revision _revision)
+{
+	InstructionTable table;
+	table.evmVersion = toEVMVersion(_revision);
+	table.gas.fill(-1);
+	table.args.fill(0);
+	table.ret.fill(0);
+	for (size_t opcode = 0; opcode < 256; ++opcode)
+	{
+		Instruction instruction = Instruction(opcode);
+		if (
+			!isValidInstruction(instruction) ||
+			instruction == Instruction::INVALID ||
+			!table.evmVersion.hasOpcode(instruction) ||
+			(instruction == Instruction::REVERT && !table.evmVersion.supportsReturndata())
+		)
+			continue;
+		InstructionInfo info = instructionInfo(instruction);
+		table.gas[opcode] = staticGas(instruction, table.evmVersion);
+		table.args[opcode] = size_t(info.args);
+		table.ret[opcode] = size_t(info.ret);
+	}
+	return table;
+}
+
+InstructionTable const& instructionTable(evmc_revision _revision)
+{
+	static array<InstructionTable, EVMC_MAX_REVISION + 1> const tables = []() {
+		array<InstructionTable, EVMC_MAX_REVISION + 1> result;
+		for (size_t revision = 0; revision <= EVMC_MAX_REVISION; ++revision)
+			result[revision] = makeInstructionTable(evmc_revision(revision));
+		return result;
+	}();
+	return tables.at(size_t(_revision));
+}
+
+u256 toU256(evmc_bytes32 const& _value)
+{
+	return fromBigEndian<u256>(bytesConstRef(_value.bytes, sizeof(_value.bytes)));
+}
+
+u256 toU256(evmc_address const& _address)
+{
+	return fromBigEndian<u256>(bytesConstRef(_address.bytes, sizeof(_address.bytes)));
+}
+
+evmc_bytes32 toBytes32(u256 const& _value)
+{
+	evmc_bytes32 result;
+	bytesRef data(result.bytes, sizeof(result.bytes));
+	toBigEndian(_value, data);
+	return result;
+}
+
+evmc_address toAddress(u256 const& _value)
+{
+	evmc_address result;
+	bytesRef data(result.bytes, sizeof(result.bytes));
+	toBigEndian(_value, data);
+	return result;
+}
+
+size_t wordCount(size_t _size)
+{
+	return (_size + 31) / 32;
+}
+
+/// State of the execution of a single message.
+class Execution
+{
+public:
+	Execution(
+		evmc_context* _context,
+		evmc_revision _revision,
+		evmc_message const& _message,
+		uint8_t const* _code,
+		size_t _codeSize
+	):
+		m_host(_context),
+		m_revision(_revision),
+		m_table(instructionTable(_revision)),
+		m_message(_message),
+		m_code(_code, _codeSize),
+		m_input(_message.input_data, _message.input_size),
+		m_gas(_message.gas)
+	{
+		m_stack.reserve(GasCosts::stackLimit);
+		m_jumpDestinations.resize(m_code.size(), false);
+		for (size_t pc = 0; pc < m_code.size(); ++pc)
+		{
+			Instruction instruction = Instruction(m_code[pc]);
+			if (instruction == Instruction::JUMPDEST)
+				m_jumpDestinations[pc] = true;
+			else if (isPushInstruction(instruction))
+				pc += getPushNumber(instruction);
+		}
+	}
+
+	evmc_result run() noexcept
+	{
+		evmc_status_code status = EVMC_SUCCESS;
+		try
+		{
+			status = execute();
+		}
+		catch (ExecutionFailure const& _failure)
+		{
+			status = _failure.status;
+		}
+		catch (...)
+		{
+			status = EVMC_INTERNAL_ERROR;
+		}
+
+		evmc_result result{};
+		result.status_code = status;
+		if (status == EVMC_SUCCESS || status == EVMC_REVERT)
+		{
+			result.gas_left = m_gas;
+			if (!m_output.empty())
+			{
+				uint8_t* output = new uint8_t[m_output.size()];
+				memcpy(output, m_output.data(), m_output.size());
+				result.output_data = output;
+				result.output_size = m_output.size();
+				result.release = [](evmc_result const* _result) { delete[] _result->output_data; };
+			}
+		}
+		return result;
+	}
+
+private:
+	evmc_status_code execute()
+	{
+		size_t pc = 0;
+		while (pc < m_code.size())
+		{
+			uint8_t const opcode = m_code[pc];
+			Instruction const instruction = Instruction(opcode);
+			if (m_table.gas[opcode] < 0)
+				throw ExecutionFailure{
+					instruction == Instruction::INVALID ? EVMC_INVALID_INSTRUCTION : EVMC_UNDEFINED_INSTRUCTION
+				};
+			if (m_stack.size() < m_table.args[opcode])
+				throw ExecutionFailure{EVMC_STACK_UNDERFLOW};
+			if (m_stack.size() - m_table.args[opcode] + m_table.ret[opcode] > GasCosts::stackLimit)
+				throw ExecutionFailure{EVMC_STACK_OVERFLOW};
+			consumeGas(m_table.gas[opcode]);
+
+			switch (instruction)
+			{
+			case Instruction::STOP:
+				return EVMC_SUCCESS;
+			case Instruction::ADD:
+			{
+				u256 a = pop();
+				top() += a;
+				break;
+			}
+			case Instruction::MUL:
+			{
+				u256 a = pop();
+				top() *= a;
+				break;
+			}
+			case Instruction::SUB:
+			{
+				u256 a = pop();
+				top() = a - top();
+				break;
+			}
+			case Instruction::DIV:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? u256(0) : u256(a / top());
+				break;
+			}
+			case Instruction::SDIV:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? u256(0) : s2u(u2s(a) / u2s(top()));
+				break;
+			}
+			case Instruction::MOD:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? u256(0) : u256(a % top());
+				break;
+			}
+			case Instruction::SMOD:
+			{
+				u256 a = pop();
+				top() = top() == 0 ? u256(0) : s2u(u2s(a) % u2s(top()));
+				break;
+			}
+			case Instruction::ADDMOD:
+			{
+				u256 a = pop();
+				u256 b = pop();
+				top() = top() == 0 ? u256(0) : u256((u512(a) + u512(b)) % u512(top()));
+				break;
+			}
+			case Instruction::MULMOD:
+			{
+				u256 a = pop();
+				u256 b = pop();
+				top() = top() == 0 ? u256(0) : u256((u512(a) * u512(b)) % u512(top()));
+				break;
+			}
+			case Instruction::EXP:
+			{
+				u256 base = pop();
+				u256& exponent = top();
+				if (exponent != 0)
+					consumeGas(GasCosts::expByteGas(m_table.evmVersion) * int64_t(bytesRequired(exponent)));
+				exponent = exp256(base, exponent);
+				break;
+			}
+			case Instruction::SIGNEXTEND:
+			{
+				u256 position = pop();
+				u256& value = top();
+				if (position < 31)
+				{
+					unsigned testBit = unsigned(position) * 8 + 7;
+					u256 mask = (u256(1) << testBit) - 1;
+					if (boost::multiprecision::bit_test(value, testBit))
+						value |= ~mask;
+					else
+						value &= mask;
+				}
+				break;
+			}
+			case Instruction::LT:
+			{
+				u256 a = pop();
+				top() = a < top() ? 1 : 0;
+				break;
+			}
+			case Instruction::GT:
+			{
+				u256 a = pop();
+				top() = a > top() ? 1 : 0;
+				break;
+			}
+			case Instruction::SLT:
+			{
+				u256 a = pop();
+				top() = u2s(a) < u2s(top()) ? 1 : 0;
+				break;
+			}
+			case Instruction::SGT:
+			{
+				u256 a = pop();
+				top() = u2s(a) > u2s(top()) ? 1 : 0;
+				break;
+			}
+			case Instruction::EQ:
+			{
+				u256 a = pop();
+				top() = a == top() ? 1 : 0;
+				break;
+			}
+			case Instruction::ISZERO:
+				top() = top() == 0 ? 1 : 0;
+				break;
+			case Instruction::AND:
+			{
+				u256 a = pop();
+				top() &= a;
+				break;
+			}
+			case Instruction::OR:
+			{
+				u256 a = pop();
+				top() |= a;
+				break;
+			}
+			case Instruction::XOR:
+			{
+				u256 a = pop();
+				top() ^= a;
+				break;
+			}
+			case Instruction::NOT:
+				top() = ~top();
+				break;
+			case Instruction::BYTE:
+			{
+				u256 position = pop();
+				top() = position >= 32 ? u256(0) : u256((top() >> unsigned(8 * (31 - position))) & 0xff);
+				break;
+			}
+			case Instruction::SHL:
+			{
+				u256 shift = pop();
+				top() = shift > 255 ? u256(0) : u256(top() << unsigned(shift));
+				break;
+			}
+			case Instruction::SHR:
+			{
+				u256 shift = pop();
+				top() = shift > 255 ? u256(0) : u256(top() >> unsigned(shift));
+				break;
+			}
+			case Instruction::SAR:
+			{
+				u256 shift = pop();
+				u256& value = top();
+				bool negative = boost::multiprecision::bit_test(value, 255);
+				if (shift > 255)
+					value = negative ? ~u256(0) : u256(0);
+				else if (shift > 0)
+				{
+					value >>= unsigned(shift);
+					if (negative)
+						value |= ~u256(0) << (256 - unsigned(shift));
+				}
+				break;
+			}
+			case Instruction::KECCAK256:
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				size_t memoryOffset = accessMemory(offset, size);
+				consumeGas(GasCosts::keccak256WordGas * int64_t(wordCount(size_t(size))));
+				push(u256(keccak256(bytesConstRef(m_memory.data() + memoryOffset, size_t(size)))));
+				break;
+			}
+			case Instruction::ADDRESS:
+				push(toU256(m_message.destination));
+				break;
+			case Instruction::BALANCE:
+				top() = toU256(m_host.get_balance(toAddress(top())));
+				break;
+			case Instruction::ORIGIN:
+				push(toU256(m_host.get_tx_context().tx_origin));
+				break;
+			case Instruction::CALLER:
+				push(toU256(m_message.sender));
+				break;
+			case Instruction::CALLVALUE:
+				push(toU256(m_message.value));
+				break;
+			case Instruction::CALLDATALOAD:
+			{
+				bytes word(32);
+				copyZeroExtended(word.data(), m_input, top(), 32);
+				top() = fromBigEndian<u256>(word);
+				break;
+			}
+			case Instruction::CALLDATASIZE:
+				push(m_input.size());
+				break;
+			case Instruction::CALLDATACOPY:
+				copyToMemory(m_input);
+				break;
+			case Instruction::CODESIZE:
+				push(m_code.size());
+				break;
+			case Instruction::CODECOPY:
+				copyToMemory(m_code);
+				break;
+			case Instruction::GASPRICE:
+				push(toU256(m_host.get_tx_context().tx_gas_price));
+				break;
+			case Instruction::EXTCODESIZE:
+				top() = m_host.get_code_size(toAddress(top()));
+				break;
+			case Instruction::EXTCODECOPY:
+			{
+				evmc_address address = toAddress(pop());
+				u256 memoryOffset = pop();
+				u256 codeOffset = pop();
+				u256 size = pop();
+				size_t offset = accessMemory(memoryOffset, size);
+				consumeGas(GasCosts::copyGas * int64_t(wordCount(size_t(size))));
+				if (size > 0)
+				{
+					size_t copied = 0;
+					if (codeOffset < c_memoryLimit)
+						copied = m_host.copy_code(address, size_t(codeOffset), m_memory.data() + offset, size_t(size));
+					memset(m_memory.data() + offset + copied, 0, size_t(size) - copied);
+				}
+				break;
+			}
+			case Instruction::RETURNDATASIZE:
+				push(m_returnData.size());
+				break;
+			case Instruction::RETURNDATACOPY:
+			{
+				u256 memoryOffset = pop();
+				u256 dataOffset = pop();
+				u256 size = pop();
+				if (dataOffset + size > m_returnData.size())
+					throw ExecutionFailure{EVMC_INVALID_MEMORY_ACCESS};
+				size_t offset = accessMemory(memoryOffset, size);
+				consumeGas(GasCosts::copyGas * int64_t(wordCount(size_t(size))));
+				if (size > 0)
+					memcpy(m_memory.data() + offset, m_returnData.data() + size_t(dataOffset), size_t(size));
+				break;
+			}
+			case Instruction::EXTCODEHASH:
+				top() = toU256(m_host.get_code_hash(toAddress(top())));
+				break;
+			case Instruction::BLOCKHASH:
+			{
+				int64_t currentNumber = m_host.get_tx_context().block_number;
+				u256& number = top();
+				if (number < u256(currentNumber) && u256(currentNumber) - number <= 256)
+					number = toU256(m_host.get_block_hash(int64_t(number)));
+				else
+					number = 0;
+				break;
+			}
+			case Instruction::COINBASE:
+				push(toU256(m_host.get_tx_context().block_coinbase));
+				break;
+			case Instruction::TIMESTAMP:
+				push(m_host.get_tx_context().block_timestamp);
+				break;
+			case Instruction::NUMBER:
+				push(m_host.get_tx_context().block_number);
+				break;
+			case Instruction::DIFFICULTY:
+				push(toU256(m_host.get_tx_context().block_difficulty));
+				break;
+			case Instruction::GASLIMIT:
+				push(m_host.get_tx_context().block_gas_limit);
+				break;
+			case Instruction::POP:
+				m_stack.pop_back();
+				break;
+			case Instruction::MLOAD:
+			{
+				size_t offset = accessMemory(top(), 32);
+				top() = fromBigEndian<u256>(bytesConstRef(m_memory.data() + offset, 32));
+				break;
+			}
+			case Instruction::MSTORE:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				size_t memoryOffset = accessMemory(offset, 32);
+				bytesRef word(m_memory.data() + memoryOffset, 32);
+				toBigEndian(value, word);
+				break;
+			}
+			case Instruction::MSTORE8:
+			{
+				u256 offset = pop();
+				u256 value = pop();
+				size_t memoryOffset = accessMemory(offset, 1);
+				m_memory[memoryOffset] = uint8_t(value & 0xff);
+				break;
+			}
+			case Instruction::SLOAD:
+				top() = toU256(m_host.get_storage(m_message.destination, toBytes32(top())));
+				break;
+			case Instruction::SSTORE:
+			{
+				requireNonStatic();
+				evmc_bytes32 key = toBytes32(pop());
+				evmc_bytes32 value = toBytes32(pop());
+				evmc_storage_status status = m_host.set_storage(m_message.destination, key, value);
+				consumeGas(storeGas(status));
+				break;
+			}
+			case Instruction::JUMP:
+				pc = jumpTarget(pop());
+				continue;
+			case Instruction::JUMPI:
+			{
+				u256 target = pop();
+				if (pop() != 0)
+				{
+					pc = jumpTarget(target);
+					continue;
+				}
+				break;
+			}
+			case Instruction::PC:
+				push(pc);
+				break;
+			case Instruction::MSIZE:
+				push(m_memory.size());
+				break;
+			case Instruction::GAS:
+				push(m_gas);
+				break;
+			case Instruction::JUMPDEST:
+				break;
+			case Instruction::LOG0:
+			case Instruction::LOG1:
+			case Instruction::LOG2:
+			case Instruction::LOG3:
+			case Instruction::LOG4:
+			{
+				requireNonStatic();
+				u256 offset = pop();
+				u256 size = pop();
+				size_t memoryOffset = accessMemory(offset, size);
+				consumeGas(GasCosts::logDataGas * int64_t(size));
+				array<evmc_bytes32, 4> topics;
+				unsigned topicCount = getLogNumber(instruction);
+				for (unsigned i = 0; i < topicCount; ++i)
+					topics[i] = toBytes32(pop());
+				m_host.emit_log(m_message.destination, m_memory.data() + memoryOffset, size_t(size), topics.data(), topicCount);
+				break;
+			}
+			case Instruction::CREATE:
+			case Instruction::CREATE2:
+				create(instruction);
+				break;
+			case Instruction::CALL:
+			case Instruction::CALLCODE:
+			case Instruction::DELEGATECALL:
+			case Instruction::STATICCALL:
+				call(instruction);
+				break;
+			case Instruction::RETURN:
+			case Instruction::REVERT:
+			{
+				u256 offset = pop();
+				u256 size = pop();
+				size_t memoryOffset = accessMemory(offset, size);
+				m_output.assign(m_memory.begin() + ptrdiff_t(memoryOffset), m_memory.begin() + ptrdiff_t(memoryOffset + size_t(size)));
+				return instruction == Instruction::RETURN ? EVMC_SUCCESS : EVMC_REVERT;
+			}
+			case Instruction::SELFDESTRUCT:
+			{
+				requireNonStatic();
+				evmc_address beneficiary = toAddress(pop());
+				if (m_table.evmVersion >= langutil::EVMVersion::tangerineWhistle())
+				{
+					bool chargeNewAccount =
+						m_table.evmVersion >= langutil::EVMVersion::spuriousDragon() ?
+						toU256(m_host.get_balance(m_message.destination)) != 0 :
+						true;
+					if (chargeNewAccount && !m_host.account_exists(beneficiary))
+						consumeGas(GasCosts::callNewAccountGas);
+				}
+				m_host.selfdestruct(m_message.destination, beneficiary);
+				return EVMC_SUCCESS;
+			}
+			default:
+				if (isPushInstruction(instruction))
+				{
+					size_t length = getPushNumber(instruction);
+					bytes data(length);
+					copyZeroExtended(data.data(), m_code, pc + 1, length);
+					push(fromBigEndian<u256>(data));
+					pc += length;
+				}
+				else if (isDupInstruction(instruction))
+					push(top(getDupNumber(instruction) - 1));
+				else if (isSwapInstruction(instruction))
+					swap(top(), top(getSwapNumber(instruction)));
+				else
+					throw ExecutionFailure{EVMC_UNDEFINED_INSTRUCTION};
+				break;
+			}
+			++pc;
+		}
+		return EVMC_SUCCESS;
+	}
+
+	/// Executes CREATE or CREATE2.
+	void create(Instruction _instruction)
+	{
+		requireNonStatic();
+		u256 value = pop();
+		u256 offset = pop();
+		u256 size = pop();
+		evmc_message message{};
+		message.kind = _instruction == Instruction::CREATE2 ? EVMC_CREATE2 : EVMC_CREATE;
+		if (_instruction == Instruction::CREATE2)
+			message.create2_salt = toBytes32(pop());
+		size_t memoryOffset = accessMemory(offset, size);
+		if (_instruction == Instruction::CREATE2)
+			consumeGas(GasCosts::keccak256WordGas * int64_t(wordCount(size_t(size))));
+
+		m_returnData.clear();
+		if (m_message.depth >= c_maxCallDepth || toU256(m_host.get_balance(m_message.destination)) < value)
+		{
+			push(0);
+			return;
+		}
+
+		message.depth = m_message.depth + 1;
+		message.gas = m_gas;
+		if (m_table.evmVersion.canOverchargeGasForCall())
+			message.gas -= message.gas / 64;
+		message.sender = m_message.destination;
+		message.input_data = m_memory.data() + memoryOffset;
+		message.input_size = size_t(size);
+		message.value = toBytes32(value);
+		consumeGas(message.gas);
+
+		evmc::result result = m_host.call(message);
+		m_gas += result.gas_left;
+		if (result.status_code == EVMC_REVERT)
+			m_returnData.assign(result.output_data, result.output_data + result.output_size);
+		push(result.status_code == EVMC_SUCCESS ? toU256(result.create_address) : u256(0));
+	}
+
+	/// Executes CALL, CALLCODE, DELEGATECALL or STATICCALL.
+	void call(Instruction _instruction)
+	{
+		u256 gas = pop();
+		evmc_address destination = toAddress(pop());
+		u256 value = 0;
+		if (_instruction == Instruction::CALL || _instruction == Instruction::CALLCODE)
+			value = pop();
+		u256 inputOffset = pop();
+		u256 inputSize = pop();
+		u256 outputOffset = pop();
+		u256 outputSize = pop();
+
+		size_t input = accessMemory(inputOffset, inputSize);
+		size_t output = accessMemory(outputOffset, outputSize);
+
+		evmc_message message{};
+		message.kind =
+			_instruction == Instruction::DELEGATECALL ? EVMC_DELEGATECALL :
+			_instruction == Instruction::CALLCODE ? EVMC_CALLCODE :
+			EVMC_CALL;
+		message.flags = m_message.flags;
+		message.depth = m_message.depth + 1;
+		message.destination = destination;
+		message.sender = m_message.destination;
+		message.input_data = m_memory.data() + input;
+		message.input_size = size_t(inputSize);
+		message.value = toBytes32(value);
+		if (_instruction == Instruction::STATICCALL)
+			message.flags |= EVMC_STATIC;
+		else if (_instruction == Instruction::DELEGATECALL)
+		{
+			message.sender = m_message.sender;
+			message.value = m_message.value;
+		}
+
+		if (value != 0)
+		{
+			if (_instruction == Instruction::CALL)
+				requireNonStatic();
+			consumeGas(GasCosts::callValueTransferGas);
+		}
+		if (_instruction == Instruction::CALL)
+		{
+			bool chargeNewAccount =
+				m_table.evmVersion >= langutil::EVMVersion::spuriousDragon() ?
+				value != 0 :
+				true;
+			if (chargeNewAccount && !m_host.account_exists(destination))
+				consumeGas(GasCosts::callNewAccountGas);
+		}
+
+		if (m_table.evmVersion.canOverchargeGasForCall())
+			message.gas = int64_t(min(gas, u256(m_gas - m_gas / 64)));
+		else if (gas > m_gas)
+			throw ExecutionFailure{EVMC_OUT_OF_GAS};
+		else
+			message.gas = int64_t(gas);
+		consumeGas(message.gas);
+		if (value != 0)
+			message.gas += GasCosts::callStipend;
+
+		m_returnData.clear();
+		if (
+			m_message.depth >= c_maxCallDepth ||
+			(value != 0 && toU256(m_host.get_balance(m_message.destination)) < value)
+		)
+		{
+			m_gas += message.gas;
+			push(0);
+			return;
+		}
+
+		evmc::result result = m_host.call(message);
+		m_gas += result.gas_left;
+		m_returnData.assign(result.output_data, result.output_data + result.output_size);
+		if (outputSize > 0)
+			memcpy(m_memory.data() + output, m_returnData.data(), min(size_t(outputSize), m_returnData.size()));
+		push(result.status_code == EVMC_SUCCESS ? 1 : 0);
+	}
+
+	int64_t storeGas(evmc_storage_status _status) const
+	{
+		if (m_revision == EVMC_CONSTANTINOPLE)
+			// Net gas metering as specified in EIP-1283.
+			switch (_status)
+			{
+			case EVMC_STORAGE_UNCHANGED:
+			case EVMC_STORAGE_MODIFIED_AGAIN:
+				return GasCosts::sloadGas(m_table.evmVersion);
+			case EVMC_STORAGE_ADDED:
+				return GasCosts::sstoreSetGas;
+			default:
+				return GasCosts::sstoreResetGas;
+			}
+		else if (_status == EVMC_STORAGE_ADDED)
+			return GasCosts::sstoreSetGas;
+		else
+			return GasCosts::sstoreResetGas;
+	}
+
+	/// Charges gas for memory expansion if the area of @a _size bytes starting at
+	/// @a _offset is not yet part of the memory.
+	/// @returns the offset as a native integer.
+	size_t accessMemory(u256 const& _offset, u256 const& _size)
+	{
+		if (_size == 0)
+			return 0;
+		if (_offset >= c_memoryLimit || _size >= c_memoryLimit)
+			throw ExecutionFailure{EVMC_OUT_OF_GAS};
+		size_t end = size_t(_offset) + size_t(_size);
+		if (end > m_memory.size())
+		{
+			size_t words = wordCount(end);
+			consumeGas(memoryGas(words) - memoryGas(m_memory.size() / 32));
+			m_memory.resize(words * 32);
+		}
+		return size_t(_offset);
+	}
+
+	static int64_t memoryGas(size_t _words)
+	{
+		return int64_t(GasCosts::memoryGas * _words + _words * _words / GasCosts::quadCoeffDiv);
+	}
+
+	/// Executes CALLDATACOPY or CODECOPY with @a _source.
+	void copyToMemory(bytesConstRef _source)
+	{
+		u256 memoryOffset = pop();
+		u256 sourceOffset = pop();
+		u256 size = pop();
+		size_t offset = accessMemory(memoryOffset, size);
+		consumeGas(GasCosts::copyGas * int64_t(wordCount(size_t(size))));
+		if (size > 0)
+			copyZeroExtended(m_memory.data() + offset, _source, sourceOffset, size_t(size));
+	}
+
+	/// Copies @a _size bytes of @a _source starting at @a _sourceOffset to @a _target,
+	/// as if @a _source was followed by an infinite number of zero bytes.
+	static void copyZeroExtended(uint8_t* _target, bytesConstRef _source, u256 const& _sourceOffset, size_t _size)
+	{
+		size_t offset = _sourceOffset < _source.size() ? size_t(_sourceOffset) : _source.size();
+		size_t available = min(_size, _source.size() - offset);
+		if (available > 0)
+			memcpy(_target, _source.data() + offset, available);
+		memset(_target + available, 0, _size - available);
+	}
+
+	size_t jumpTarget(u256 const& _target) const
+	{
+		if (_target >= m_code.size() || !m_jumpDestinations[size_t(_target)])
+			throw ExecutionFailure{EVMC_BAD_JUMP_DESTINATION};
+		return size_t(_target);
+	}
+
+	void requireNonStatic() const
+	{
+		if (m_message.flags & EVMC_STATIC)
+			throw ExecutionFailure{EVMC_STATIC_MODE_VIOLATION};
+	}
+
+	void consumeGas(int64_t _amount)
+	{
+		if (_amount > m_gas)
+			throw ExecutionFailure{EVMC_OUT_OF_GAS};
+		m_gas -= _amount;
+	}
+
+	u256 pop()
+	{
+		u256 value = std::move(m_stack.back());
+		m_stack.pop_back();
+		return value;
+	}
+
+	void push(u256 _value)
+	{
+		m_stack.emplace_back(std::move(_value));
+	}
+
+	u256& top(size_t _depth = 0)
+	{
+		return m_stack[m_stack.size() - 1 - _depth];
+	}
+
+	evmc::HostContext m_host;
+	evmc_revision m_revision;
+	InstructionTable const& m_table;
+	evmc_message const& m_message;
+	bytesConstRef m_code;
+	bytesConstRef m_input;
+	/// Whether the byte at the respective position of the code is a valid jump destination,
+	/// i.e. a JUMPDEST that is not part of push data.
+	vector<bool> m_jumpDestinations;
+	int64_t m_gas = 0;
+	vector<u256> m_stack;
+	bytes m_memory;
+	bytes m_returnData;
+	bytes m_output;
+};
+
+evmc_result execute(
+	evmc_instance*,
+	evmc_context* _context,
+	evmc_revision _revision,
+	evmc_message const* _message,
+	uint8_t const* _code,
+	size_t _codeSize
+)
+{
+	return Execution(_context, _revision, *_message, _code, _codeSize).run();
+}
+
+}
+
+evmc_instance* dev::test::createEVMInterpreter()
+{
+	return new evmc_instance{
+		EVMC_ABI_VERSION,
+		"soltest-interpreter",
+		"0.1.0",
+		[](evmc_instance* _instance) { delete _instance; },
+		execute,
+		[](evmc_instance*) -> evmc_capabilities_flagset { return EVMC_CAPABILITY_EVM1; },
+		nullptr,
+		nullptr
+	};
+}
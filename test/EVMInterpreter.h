@@ -0,0 +1,38 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Built-in EVM bytecode interpreter, used to run the semantic tests
+ * if no external VM is available.
+ */
+
+#pragma once
+
+#include <test/evmc/evmc.h>
+
+namespace dev
+{
+namespace test
+{
+
+/// Creates a new instance of the built-in EVM bytecode interpreter.
+/// It implements the EVMC interface for all EVM versions supported by the compiler,
+/// including their gas costs. Precompiled contracts are left to the host.
+/// The instance has to be destroyed via its `destroy` function (e.g. by evmc::vm).
+evmc_instance* createEVMInterpreter();
+
+}
+}
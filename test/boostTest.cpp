@@ -140,14 +140,9 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 	master.p_name.value = "SolidityTests";
 	dev::test::Options::get().validate();
 
-	bool disableSemantics = !dev::test::EVMHost::getVM(dev::test::Options::get().evmonePath.string());
-	if (disableSemantics)
-	{
-		cout << "Unable to find libevmone.so. Please provide the path using -- --evmonepath <path>." << endl;
-		cout << "You can download it at" << endl;
-		cout << "https://github.com/ethereum/evmone/releases/download/v0.1.0/evmone-0.1.0-linux-x86_64.tar.gz" << endl;
-		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
-	}
+	// Select the VM: libevmone if it can be found, the built-in interpreter otherwise.
+	dev::test::EVMHost::getVM(dev::test::Options::get().evmonePath.string());
+
 	// Include the interactive tests in the automatic tests as well
 	for (auto const& ts: g_interactiveTestsuites)
 	{
@@ -156,9 +151,6 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 		if (ts.smt && options.disableSMT)
 			continue;
 
-		if (ts.needsVM && disableSemantics)
-			continue;
-
 		solAssert(registerTests(
 			master,
 			options.testPath / ts.path,
@@ -167,27 +159,6 @@ test_suite* init_unit_test_suite( int /*argc*/, char* /*argv*/[] )
 		) > 0, std::string("no ") + ts.title + " tests found");
 	}
 
-	if (disableSemantics)
-	{
-		for (auto suite: {
-			"ABIDecoderTest",
-			"ABIEncoderTest",
-			"SolidityAuctionRegistrar",
-			"SolidityFixedFeeRegistrar",
-			"SolidityWallet",
-#if HAVE_LLL
-			"LLLERC20",
-			"LLLENS",
-			"LLLEndToEndTest",
-#endif
-			"GasMeterTests",
-			"GasCostTests",
-			"SolidityEndToEndTest",
-			"SolidityOptimizer"
-		})
-			removeTestSuite(suite);
-	}
-
 	if (dev::test::Options::get().disableSMT)
 		removeTestSuite("SMTChecker");
 
@@ -70,6 +70,29 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(incremental)
+{
+	string input;
+	for (size_t i = 0; i < 1000; ++i)
+		input += char('a' + i % 26);
+	for (size_t split: {0, 1, 135, 136, 137, 272, 500, 1000})
+	{
+		Keccak256Hasher hasher;
+		hasher.update(input.substr(0, split));
+		Keccak256Hasher copy = hasher;
+		hasher.update(input.substr(split));
+		BOOST_CHECK_EQUAL(hasher.digest(), keccak256(input));
+		BOOST_CHECK_EQUAL(copy.digest(), keccak256(input.substr(0, split)));
+		// Digests do not change the state.
+		BOOST_CHECK_EQUAL(hasher.digest(), keccak256(input));
+	}
+	Keccak256Hasher hasher;
+	for (char c: input)
+		hasher.update(string(1, c));
+	BOOST_CHECK_EQUAL(hasher.digest(), keccak256(input));
+	BOOST_CHECK_EQUAL(Keccak256Hasher().digest(), keccak256(bytes()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
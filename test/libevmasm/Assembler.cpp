@@ -148,6 +148,32 @@ BOOST_AUTO_TEST_CASE(all_assembly_items)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(jump_table)
+{
+	Assembly _assembly;
+	auto tag1 = _assembly.newTag();
+	auto tag2 = _assembly.newTag();
+	_assembly.append(_assembly.newJumpTable({tag2, tag1, tag2}));
+	_assembly.append(Instruction::POP);
+	_assembly.append(tag1);
+	_assembly.append(tag2);
+	_assembly.append(Instruction::STOP);
+
+	checkCompilation(_assembly);
+
+	BOOST_CHECK_EQUAL(_assembly.assemble().toHex(), "6007505b5b00fe000400030004");
+	BOOST_CHECK_EQUAL(
+		_assembly.assemblyString(),
+		"  pop(data_37e0c1d92c9ad407698f0f7a881cda5904e13fa53c170edcf1e26a306b9a859b)\n"
+		"tag_1:\n"
+		"tag_2:\n"
+		"  stop\n"
+		"stop\n"
+		"data_37e0c1d92c9ad407698f0f7a881cda5904e13fa53c170edcf1e26a306b9a859b jumptable(tag_2, tag_1, tag_2)\n"
+	);
+	BOOST_CHECK_THROW(_assembly.newJumpTable({AssemblyItem(u256(1))}), AssemblyException);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
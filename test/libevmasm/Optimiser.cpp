@@ -24,6 +24,7 @@
 
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/PeepholeOptimiser.h>
+#include <libevmasm/SuperOptimiser.h>
 #include <libevmasm/JumpdestRemover.h>
 #include <libevmasm/ControlFlowGraph.h>
 #include <libevmasm/BlockDeduplicator.h>
@@ -903,9 +904,130 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_backtracking)
+{
+	// Every removal enables another rule on the items in front of it.
+	AssemblyItems items{
+		u256(1),
+		u256(2),
+		Instruction::SWAP1,
+		Instruction::SWAP1,
+		Instruction::POP,
+		Instruction::POP,
+		u256(3)
+	};
+	AssemblyItems expectation{
+		u256(3)
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_dup_swap)
+{
+	for (unsigned i = 1; i <= 16; ++i)
+	{
+		AssemblyItems items{
+			Instruction::CALLVALUE,
+			dupInstruction(i),
+			swapInstruction(i),
+			Instruction::SSTORE
+		};
+		AssemblyItems expectation{
+			Instruction::CALLVALUE,
+			dupInstruction(i),
+			Instruction::SSTORE
+		};
+		PeepholeOptimiser peepOpt(items);
+		BOOST_REQUIRE(peepOpt.optimise());
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+	AssemblyItems items{
+		Instruction::DUP1,
+		Instruction::SWAP2
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_double_not_and_triple_iszero)
+{
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		Instruction::NOT,
+		Instruction::NOT,
+		Instruction::ISZERO,
+		Instruction::ISZERO,
+		Instruction::ISZERO,
+		u256(0),
+		Instruction::SSTORE
+	};
+	AssemblyItems expectation{
+		Instruction::CALLVALUE,
+		Instruction::ISZERO,
+		u256(0),
+		Instruction::SSTORE
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_REQUIRE(peepOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+}
+
+BOOST_AUTO_TEST_CASE(peephole_zero_identity)
+{
+	vector<Instruction> ops{
+		Instruction::ADD,
+		Instruction::OR,
+		Instruction::XOR,
+		Instruction::SHL,
+		Instruction::SHR,
+		Instruction::SAR
+	};
+	for (Instruction const op: ops)
+	{
+		AssemblyItems items{
+			Instruction::CALLVALUE,
+			u256(0),
+			op,
+			u256(0),
+			Instruction::SSTORE
+		};
+		AssemblyItems expectation{
+			Instruction::CALLVALUE,
+			u256(0),
+			Instruction::SSTORE
+		};
+		PeepholeOptimiser peepOpt(items);
+		BOOST_REQUIRE(peepOpt.optimise());
+		BOOST_CHECK_EQUAL_COLLECTIONS(
+			items.begin(), items.end(),
+			expectation.begin(), expectation.end()
+		);
+	}
+	// ``sub(0, x)`` is not ``x``.
+	AssemblyItems items{
+		Instruction::CALLVALUE,
+		u256(0),
+		Instruction::SUB
+	};
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(!peepOpt.optimise());
 }
 
 BOOST_AUTO_TEST_CASE(peephole_commutative_swap1)
@@ -1075,6 +1197,60 @@ BOOST_AUTO_TEST_CASE(peephole_iszero_iszero_jumpi)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(superoptimiser_find_replacement)
+{
+	// x - 0
+	AssemblyItems items{u256(0), Instruction::SWAP1, Instruction::SUB};
+	auto replacement = SuperOptimiser::findReplacement(items);
+	BOOST_REQUIRE(replacement);
+	BOOST_CHECK(replacement->empty());
+
+	// x, x * 1
+	items = AssemblyItems{u256(1), Instruction::DUP2, Instruction::MUL};
+	replacement = SuperOptimiser::findReplacement(items);
+	BOOST_REQUIRE(replacement);
+	AssemblyItems expectation{Instruction::DUP1};
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		replacement->begin(), replacement->end(),
+		expectation.begin(), expectation.end()
+	);
+
+	// Nothing to improve.
+	BOOST_CHECK(!SuperOptimiser::findReplacement({Instruction::DUP2, Instruction::DUP2, Instruction::SUB}));
+	BOOST_CHECK(!SuperOptimiser::findReplacement({u256(7), Instruction::DUP2, Instruction::SUB}));
+}
+
+BOOST_AUTO_TEST_CASE(superoptimiser_basic_blocks)
+{
+	AssemblyItems items{
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		u256(1),
+		Instruction::DUP2,
+		Instruction::MUL,
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	AssemblyItems expectation{
+		AssemblyItem(Tag, 1),
+		u256(0),
+		Instruction::CALLDATALOAD,
+		Instruction::DUP1,
+		Instruction::SSTORE,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMP
+	};
+	SuperOptimiser superOpt(items);
+	BOOST_REQUIRE(superOpt.optimise());
+	BOOST_CHECK_EQUAL_COLLECTIONS(
+		items.begin(), items.end(),
+		expectation.begin(), expectation.end()
+	);
+	BOOST_CHECK(!superOpt.optimise());
+}
+
 BOOST_AUTO_TEST_CASE(jumpdest_removal)
 {
 	AssemblyItems items{
@@ -0,0 +1,115 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the binary AST format.
+ */
+
+#include <test/Options.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+void checkRoundTrip(Json::Value const& _json)
+{
+	bytes binary = ASTBinaryConverter::encode(_json);
+	BOOST_CHECK_EQUAL(jsonCompactPrint(ASTBinaryConverter::toJson(binary)), jsonCompactPrint(_json));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(SolidityASTBinary)
+
+BOOST_AUTO_TEST_CASE(values)
+{
+	Json::Value json(Json::objectValue);
+	json["null"] = Json::nullValue;
+	json["true"] = true;
+	json["false"] = false;
+	json["int"] = -1234567;
+	json["uint"] = Json::UInt64(1) << 60;
+	json["double"] = 0.5;
+	json["empty"] = "";
+	json["src"] = "12:34:0";
+	json["noSrc"] = "-1:-1:-1";
+	json["notSrc"] = Json::arrayValue;
+	for (string str: {"1:2", "01:2:3", "-0:1:2", "1:2:3:", "1:2:a", "1:2:3:4", ":1:2", "1234567890123456789:1:2"})
+		json["notSrc"].append(str);
+	json["nested"]["array"].append(Json::objectValue);
+	json["nested"]["array"].append("src");
+	checkRoundTrip(json);
+}
+
+BOOST_AUTO_TEST_CASE(invalid)
+{
+	BOOST_CHECK_THROW(ASTBinaryConverter::toJson(bytes{}), InvalidBinaryAST);
+	BOOST_CHECK_THROW(ASTBinaryConverter::toJson(asBytes("JSON")), InvalidBinaryAST);
+
+	bytes binary = ASTBinaryConverter::encode(Json::Value("x"));
+	BOOST_CHECK_THROW(ASTBinaryConverter::toJson(bytes(binary.begin(), binary.end() - 1)), InvalidBinaryAST);
+	binary.push_back(0);
+	BOOST_CHECK_THROW(ASTBinaryConverter::toJson(binary), InvalidBinaryAST);
+}
+
+BOOST_AUTO_TEST_CASE(ast_json_tests)
+{
+	// Every AST of the AST JSON tests has to survive the round trip and be smaller than its JSON form.
+	boost::filesystem::path const path = dev::test::Options::get().testPath / "libsolidity" / "ASTJSON";
+	BOOST_REQUIRE(boost::filesystem::is_directory(path));
+	size_t count = 0;
+	for (auto const& entry: boost::filesystem::directory_iterator(path))
+	{
+		if (entry.path().extension() != ".sol")
+			continue;
+		CompilerStack compilerStack;
+		compilerStack.setSources({{entry.path().filename().string(), readFileAsString(entry.path().string())}});
+		if (!compilerStack.parseAndAnalyze())
+			continue;
+		for (string const& sourceName: compilerStack.sourceNames())
+		{
+			SourceUnit const& ast = compilerStack.ast(sourceName);
+			Json::Value json = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(ast);
+			bytes binary = ASTBinaryConverter(compilerStack.sourceIndices()).toBinary(ast);
+			BOOST_CHECK_EQUAL(jsonCompactPrint(ASTBinaryConverter::toJson(binary)), jsonCompactPrint(json));
+			BOOST_CHECK_LT(binary.size(), jsonCompactPrint(json).size());
+			++count;
+		}
+	}
+	BOOST_CHECK(count > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+} // end namespaces
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the sharing of SMT expressions.
+ */
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::Expression;
+using smt::ExpressionCache;
+
+BOOST_AUTO_TEST_SUITE(SMTExpressionTest)
+
+BOOST_AUTO_TEST_CASE(structurally_equal_expressions_are_shared)
+{
+	Expression a = Expression(size_t(1)) + Expression(size_t(2));
+	Expression b = Expression(size_t(1)) + Expression(size_t(2));
+	Expression c = Expression(size_t(2)) + Expression(size_t(1));
+	BOOST_CHECK_EQUAL(a.hash(), b.hash());
+	BOOST_CHECK_EQUAL(&a.arguments(), &b.arguments());
+	BOOST_CHECK(&a.arguments() != &c.arguments());
+	BOOST_CHECK_EQUAL(&a.arguments()[0].arguments(), &c.arguments()[1].arguments());
+}
+
+BOOST_AUTO_TEST_CASE(cache)
+{
+	ExpressionCache<int> cache;
+	auto a = make_unique<Expression>(Expression(size_t(7)) * Expression(size_t(3)));
+	cache.insert(*a, 1);
+	Expression b = Expression(size_t(7)) * Expression(size_t(3));
+	BOOST_REQUIRE(cache.find(b));
+	BOOST_CHECK_EQUAL(*cache.find(b), 1);
+	BOOST_CHECK(!cache.find(Expression(size_t(3)) * Expression(size_t(7))));
+	a.reset();
+	BOOST_CHECK(cache.find(b));
+	cache.clear();
+	BOOST_CHECK(!cache.find(b));
+}
+
+BOOST_AUTO_TEST_CASE(cache_does_not_keep_expressions_alive)
+{
+	ExpressionCache<int> cache;
+	{
+		Expression a = Expression(size_t(11)) - Expression(size_t(5));
+		cache.insert(a, 1);
+	}
+	BOOST_CHECK(!cache.find(Expression(size_t(11)) - Expression(size_t(5))));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the SMT-LIB2 interface.
+ */
+
+#include <libsolidity/formal/SMTLib2Interface.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::CheckResult;
+using smt::Expression;
+
+BOOST_AUTO_TEST_SUITE(SMTLib2InterfaceTest)
+
+BOOST_AUTO_TEST_CASE(responses_are_looked_up_by_query_hash)
+{
+	map<h256, string> responses;
+	smt::SMTLib2Interface interface(responses);
+	Expression x = interface.newVariable("x", make_shared<smt::Sort>(smt::Kind::Int));
+	interface.addAssertion(x > Expression(size_t(2)));
+	interface.push();
+	interface.addAssertion(x < Expression(size_t(1)));
+	responses[keccak256(interface.query({}))] = "unsat\n";
+	BOOST_CHECK(interface.check({}).first == CheckResult::UNSATISFIABLE);
+	interface.pop();
+
+	interface.push();
+	interface.addAssertion(x > Expression(size_t(3)));
+	string query = interface.query({x});
+	responses[keccak256(query)] = "sat\n((|EVALEXPR_0| 4))\n";
+	auto result = interface.check({x});
+	BOOST_CHECK(result.first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(result.second == vector<string>{"4"});
+	interface.pop();
+	BOOST_CHECK(interface.checkAssuming({x > Expression(size_t(3))}, {x}).first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(interface.query({x}, {x > Expression(size_t(3))}) == query);
+
+	BOOST_CHECK(interface.unhandledQueries().empty());
+	BOOST_CHECK(interface.check({}).first == CheckResult::UNKNOWN);
+	BOOST_CHECK(interface.unhandledQueries() == vector<string>{interface.query({})});
+}
+
+BOOST_AUTO_TEST_CASE(query_text)
+{
+	map<h256, string> responses;
+	smt::SMTLib2Interface interface(responses);
+	Expression x = interface.newVariable("x", make_shared<smt::Sort>(smt::Kind::Bool));
+	interface.push();
+	interface.addAssertion(x);
+	interface.push();
+	BOOST_CHECK_EQUAL(
+		interface.query({}),
+		"(set-option :produce-models true)\n"
+		"(set-logic QF_UFLIA)\n"
+		"(declare-fun |x| () Bool)\n"
+		"\n"
+		"(assert x)\n"
+		"\n"
+		"(check-sat)\n"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the cache of SMT query results.
+ */
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/Common.h>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+using smt::CheckResult;
+using smt::SMTQueryCache;
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(normalise)
+{
+	BOOST_CHECK_EQUAL(
+		SMTQueryCache::normalise("(declare-fun |x_1| () Int)\n(assert (> |x_1| |y_0|))\n(check-sat)\n"),
+		"(declare-fun |v0| () Int)\n(assert (> |v0| |v1|))\n(check-sat)\n"
+	);
+	BOOST_CHECK_EQUAL(
+		SMTQueryCache::normalise("(assert (> |a| |b|))"),
+		SMTQueryCache::normalise("(assert (> |c| |d|))")
+	);
+	BOOST_CHECK(SMTQueryCache::normalise("(assert (> |a| |b|))") != SMTQueryCache::normalise("(assert (> |a| |a|))"));
+	BOOST_CHECK_EQUAL(SMTQueryCache::normalise("(check-sat)"), "(check-sat)");
+}
+
+BOOST_AUTO_TEST_CASE(lookup_and_store)
+{
+	SMTQueryCache cache;
+	BOOST_CHECK(!cache.lookup("(assert (> |x| 0))\n(check-sat)\n"));
+	cache.store("(assert (> |x| 0))\n(check-sat)\n", {CheckResult::SATISFIABLE, {"1", "2"}});
+	auto result = cache.lookup("(assert (> |z| 0))\n(check-sat)\n");
+	BOOST_REQUIRE(result);
+	BOOST_CHECK(result->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(result->second == vector<string>({"1", "2"}));
+	BOOST_CHECK_EQUAL(cache.hits(), 1u);
+	BOOST_CHECK_EQUAL(cache.misses(), 1u);
+
+	// Results that are not answers are not cached.
+	cache.store("(assert (> |x| 1))\n(check-sat)\n", {CheckResult::UNKNOWN, {}});
+	cache.store("(assert (> |x| 2))\n(check-sat)\n", {CheckResult::CONFLICTING, {}});
+	BOOST_CHECK(!cache.lookup("(assert (> |x| 1))\n(check-sat)\n"));
+	BOOST_CHECK(!cache.lookup("(assert (> |x| 2))\n(check-sat)\n"));
+	BOOST_CHECK_EQUAL(cache.misses(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(directory)
+{
+	boost::filesystem::path directory =
+		boost::filesystem::temp_directory_path() /
+		boost::filesystem::unique_path("solidity-smt-cache-%%%%-%%%%-%%%%");
+	ScopeGuard removeDirectory([&]() { boost::filesystem::remove_all(directory); });
+
+	{
+		SMTQueryCache cache(directory);
+		cache.store("(assert (> |x| 0))\n(check-sat)\n", {CheckResult::UNSATISFIABLE, {}});
+		cache.store("(assert (> |x| 1))\n(check-sat)\n", {CheckResult::SATISFIABLE, {"2"}});
+	}
+
+	SMTQueryCache cache(directory);
+	auto unsat = cache.lookup("(assert (> |x| 0))\n(check-sat)\n");
+	BOOST_REQUIRE(unsat);
+	BOOST_CHECK(unsat->first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(unsat->second.empty());
+	auto sat = cache.lookup("(assert (> |x| 1))\n(check-sat)\n");
+	BOOST_REQUIRE(sat);
+	BOOST_CHECK(sat->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(sat->second == vector<string>({"2"}));
+	BOOST_CHECK(!cache.lookup("(assert (> |x| 2))\n(check-sat)\n"));
+	BOOST_CHECK_EQUAL(cache.hits(), 2u);
+	BOOST_CHECK_EQUAL(cache.misses(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
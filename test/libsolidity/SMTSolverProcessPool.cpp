@@ -0,0 +1,131 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the pool of external SMT solver processes.
+ */
+
+#include <libsolidity/formal/SMTSolverProcessPool.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+#ifndef _WIN32
+
+namespace
+{
+
+/// Stub solver that answers "sat" to every check and sleeps on "(assert slow)".
+string const c_stubSolver = R"SH(#!/bin/sh
+while read -r line; do
+	case "$line" in
+		"(check-sat)") echo sat;;
+		"(assert slow)") exec sleep 10;;
+		"(echo "*) echo "$line" | sed 's/^(echo "\(.*\)")$/\1/';;
+	esac
+done
+)SH";
+
+class StubSolverFixture
+{
+public:
+	StubSolverFixture():
+		m_directory(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solidity-smt-solver-%%%%-%%%%-%%%%"))
+	{
+		boost::filesystem::create_directories(m_directory);
+		ofstream(command()) << c_stubSolver;
+		boost::filesystem::permissions(command(), boost::filesystem::owner_all);
+	}
+	~StubSolverFixture() { boost::filesystem::remove_all(m_directory); }
+
+	string command() const { return (m_directory / "solver.sh").string(); }
+
+private:
+	boost::filesystem::path m_directory;
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SMTSolverProcessPoolTest, StubSolverFixture)
+
+BOOST_AUTO_TEST_CASE(query)
+{
+	smt::SMTSolverProcessPool pool(command(), 1);
+	for (size_t i = 0; i < 3; ++i)
+	{
+		auto result = pool.query("(assert true)\n(check-sat)\n");
+		BOOST_CHECK(result.success);
+		BOOST_CHECK_EQUAL(result.responseOrErrorMessage, "sat\n");
+	}
+	auto result = pool.query("(assert true)\n");
+	BOOST_CHECK(result.success);
+	BOOST_CHECK_EQUAL(result.responseOrErrorMessage, "");
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_queries)
+{
+	smt::SMTSolverProcessPool pool(command(), 2);
+	vector<future<bool>> queries;
+	for (size_t i = 0; i < 8; ++i)
+		queries.emplace_back(async(launch::async, [&]() {
+			auto result = pool.query("(check-sat)\n(check-sat)\n");
+			return result.success && result.responseOrErrorMessage == "sat\nsat\n";
+		}));
+	for (auto& query: queries)
+		BOOST_CHECK(query.get());
+}
+
+BOOST_AUTO_TEST_CASE(timeout)
+{
+	smt::SMTSolverProcessPool pool(command(), 1, chrono::milliseconds(200));
+	auto result = pool.query("(assert slow)\n(check-sat)\n");
+	BOOST_CHECK(result.success);
+	BOOST_CHECK_EQUAL(result.responseOrErrorMessage, "unknown\n");
+	// The process is replaced.
+	result = pool.query("(check-sat)\n");
+	BOOST_CHECK(result.success);
+	BOOST_CHECK_EQUAL(result.responseOrErrorMessage, "sat\n");
+}
+
+BOOST_AUTO_TEST_CASE(missing_solver)
+{
+	smt::SMTSolverProcessPool pool(command() + "-missing -in", 1);
+	auto result = pool.query("(check-sat)\n");
+	BOOST_CHECK(!result.success);
+	BOOST_CHECK(result.responseOrErrorMessage.find("Could not start SMT solver") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+}
+}
+}
@@ -711,6 +711,30 @@ BOOST_AUTO_TEST_CASE(shift_optimizer_bug)
 	compareVersions("g(uint256)", u256(-1));
 }
 
+BOOST_AUTO_TEST_CASE(function_selector_jump_table)
+{
+	string sourceCode = "contract C {\n";
+	for (size_t i = 0; i < 40; ++i)
+		sourceCode += "function f" + to_string(i) + "(uint x) public returns (uint) { return x + " + to_string(i) + "; }\n";
+	sourceCode += "}\n";
+	// With many expected runs, the function selector uses a jump table.
+	compileBothVersions(sourceCode, 0, "C", 100000);
+	BOOST_CHECK_EQUAL(numInstructions(m_nonOptimizedBytecode, Instruction::CODECOPY), 1);
+	BOOST_CHECK_EQUAL(numInstructions(m_optimizedBytecode, Instruction::CODECOPY), 1);
+	for (size_t i = 0; i < 40; ++i)
+	{
+		compareVersions("f" + to_string(i) + "(uint256)", 7);
+		BOOST_CHECK(callContractFunction("f" + to_string(i) + "(uint256)", 7) == encodeArgs(7 + i));
+	}
+	BOOST_CHECK(callContractFunction("g()").empty());
+	BOOST_CHECK(!m_transactionSuccessful);
+
+	// With few expected runs, it uses a binary search.
+	compileBothVersions(sourceCode, 0, "C", 200);
+	BOOST_CHECK_EQUAL(numInstructions(m_optimizedBytecode, Instruction::CODECOPY), 0);
+	compareVersions("f13(uint256)", 7);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
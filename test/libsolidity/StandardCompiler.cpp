@@ -19,11 +19,14 @@
  * Unit tests for interface/StandardCompiler.h.
  */
 
+#include <sstream>
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <libsolidity/interface/StandardCompiler.h>
+#include <libsolidity/ast/ASTBinaryConverter.h>
 #include <libsolidity/interface/Version.h>
 #include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
 #include <test/Metadata.h>
 
 using namespace std;
@@ -1071,6 +1074,299 @@ BOOST_AUTO_TEST_CASE(optimizer_settings_details_different)
 	BOOST_CHECK(optimizer["runs"].asUInt() == 600);
 }
 
+BOOST_AUTO_TEST_CASE(optimizer_settings_details_super_optimizer)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata" ] }
+			},
+			"optimizer": { "enabled": true, "details": {
+				"superOptimizer" : true
+			} }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x * 1; } }"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(!optimizer.isMember("enabled"));
+	BOOST_CHECK(optimizer["details"]["cse"].asBool() == true);
+	BOOST_CHECK(optimizer["details"]["superOptimizer"].asBool() == true);
+	BOOST_CHECK_EQUAL(optimizer["details"].getMemberNames().size(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_profile)
+{
+	char const* input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"fileA": { "A": [ "metadata", "evm.deployedBytecode.object" ] }
+			},
+			"optimizer": { "enabled": true, "profile": { "h()": 100, "g()": 10 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { function f() public {} function g() public {} function h() public {} }"
+			}
+		}
+	}
+	)json";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "fileA", "A");
+	BOOST_CHECK(contract.isObject());
+	Json::Value metadata;
+	BOOST_CHECK(jsonParseStrict(contract["metadata"].asString(), metadata));
+	Json::Value const& optimizer = metadata["settings"]["optimizer"];
+	BOOST_CHECK(optimizer["enabled"].asBool() == true);
+	BOOST_CHECK(!optimizer.isMember("details"));
+	BOOST_CHECK_EQUAL(optimizer["profile"]["h()"].asUInt(), 100);
+	BOOST_CHECK_EQUAL(optimizer["profile"]["g()"].asUInt(), 10);
+
+	// The selector compares against h, then g, then f.
+	string bytecode = contract["evm"]["deployedBytecode"]["object"].asString();
+	size_t h = bytecode.find("63" + FixedHash<4>(dev::keccak256("h()")).hex());
+	size_t g = bytecode.find("63" + FixedHash<4>(dev::keccak256("g()")).hex());
+	size_t f = bytecode.find("63" + FixedHash<4>(dev::keccak256("f()")).hex());
+	BOOST_REQUIRE(h != string::npos && g != string::npos && f != string::npos);
+	BOOST_CHECK(h < g);
+	BOOST_CHECK(g < f);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_settings_invalid_profile)
+{
+	char const* input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "profile": { "f()": -1 } }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)json";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(
+		result,
+		"JSONError",
+		"The number of calls of \"f()\" in \"settings.optimizer.profile\" must be an unsigned number."
+	));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_telemetry)
+{
+	char const* input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "timeout": 1000, "totalTimeout": 60000, "resourceLimit": 1000000, "telemetry": true }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental SMTChecker; contract A { function f(uint a, uint b) public pure returns (uint) { return a + b; } }"
+			}
+		}
+	}
+	)json";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value const& queries = result["modelChecker"]["queries"];
+	BOOST_REQUIRE(queries.isArray());
+	BOOST_REQUIRE_EQUAL(queries.size(), 2);
+	BOOST_CHECK_EQUAL(queries[0]["target"].asString(), "underflow");
+	BOOST_CHECK_EQUAL(queries[1]["target"].asString(), "overflow");
+	for (Json::Value const& query: queries)
+	{
+		BOOST_CHECK_EQUAL(query["sourceLocation"]["file"].asString(), "fileA");
+		BOOST_CHECK(query["result"].isString());
+		BOOST_CHECK(query["duration"].isIntegral());
+		BOOST_REQUIRE(query["solvers"].isArray());
+		BOOST_CHECK(!query["solvers"].empty());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_no_telemetry)
+{
+	char const* input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "telemetry": false }
+		},
+		"sources": {
+			"fileA": {
+				"content": "pragma experimental SMTChecker; contract A { function f(uint a, uint b) public pure returns (uint) { return a + b; } }"
+			}
+		}
+	}
+	)json";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(!result.isMember("modelChecker"));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_function_summaries)
+{
+	auto queries = [](bool _functionSummaries) {
+		string input = R"json(
+		{
+			"language": "Solidity",
+			"settings": {
+				"modelChecker": { "telemetry": true, "functionSummaries": )json" + string(_functionSummaries ? "true" : "false") + R"json( }
+			},
+			"sources": {
+				"fileA": {
+					"content": "pragma experimental SMTChecker; contract A { function add(uint a, uint b) internal pure returns (uint) { return a + b; } function f(uint a, uint b) public pure returns (uint) { return add(add(a, b), 1); } }"
+				}
+			}
+		}
+		)json";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_REQUIRE(result["modelChecker"]["queries"].isArray());
+		return result["modelChecker"]["queries"].size();
+	};
+	// The targets of `add` are checked once when `add` is analyzed and again
+	// at both call sites if the calls are inlined.
+	BOOST_CHECK_EQUAL(queries(false), 6u);
+	BOOST_CHECK_EQUAL(queries(true), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_concurrent_contracts)
+{
+	auto compileWith = [](string const& _modelChecker) {
+		string input = R"json(
+		{
+			"language": "Solidity",
+			"settings": {
+				"modelChecker": )json" + _modelChecker + R"json(,
+				"outputSelection": { "*": { "*": [ "evm.bytecode.object" ] } }
+			},
+			"sources": {
+				"fileA": {
+					"content": "pragma experimental SMTChecker; contract A { function f(uint x) public pure { assert(x > 0); } } contract B { function g(uint8 x) public pure returns (uint8) { return x + 1; } }"
+				},
+				"fileB": {
+					"content": "pragma experimental SMTChecker; contract C { uint y; function h(uint x) public { y = x; assert(y < 10); } }"
+				}
+			}
+		}
+		)json";
+		Json::Value result = compile(input);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_CHECK(!result["contracts"]["fileB"]["C"]["evm"]["bytecode"]["object"].asString().empty());
+		vector<string> errors;
+		for (auto const& error: result["errors"])
+			errors.push_back(error["formattedMessage"].asString());
+		vector<string> targets;
+		for (auto const& query: result["modelChecker"]["queries"])
+			targets.push_back(
+				query["target"].asString() + " " +
+				query["sourceLocation"]["file"].asString() + ":" +
+				to_string(query["sourceLocation"]["start"].asInt()) + " " +
+				query["result"].asString()
+			);
+		return make_pair(errors, targets);
+	};
+	auto serial = compileWith(R"({ "telemetry": true, "threads": 1 })");
+	auto concurrent = compileWith(R"({ "telemetry": true, "threads": 3, "asynchronous": true })");
+	// Assertion violations in A and C and an overflow in B.
+	auto count = [&](string const& _message) {
+		return count_if(serial.first.begin(), serial.first.end(), [&](string const& _error) {
+			return _error.find(_message) != string::npos;
+		});
+	};
+	BOOST_CHECK_EQUAL(count("Assertion violation happens here"), 2);
+	BOOST_CHECK_EQUAL(count("Overflow (resulting value larger than 255) happens here"), 1);
+	BOOST_CHECK(serial.first == concurrent.first);
+	BOOST_CHECK(serial.second == concurrent.second);
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_invalid_settings)
+{
+	char const* input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "timeout": -1 }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)json";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.timeout\" must be an unsigned number."));
+
+	input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "budget": 1 }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)json";
+	result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"budget\""));
+
+	input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "functionSummaries": 1 }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)json";
+	result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.functionSummaries\" must be a Boolean."));
+
+	input = R"json(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "asynchronous": "yes" }
+		},
+		"sources": {
+			"fileA": {
+				"content": "contract A { }"
+			}
+		}
+	}
+	)json";
+	result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.modelChecker.asynchronous\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_CASE(metadata_without_compilation)
 {
 	// NOTE: the contract code here should fail to compile due to "out of stack"
@@ -1368,6 +1664,101 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(output_selection_ast_binary)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "contract A { function f(uint x) public pure returns (uint) { return x + 1; } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"": ["ast", "astBinary"]
+				}
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_REQUIRE(result["sources"]["a.sol"]["astBinary"].isString());
+	bytes binary = fromHex(result["sources"]["a.sol"]["astBinary"].asString());
+	BOOST_CHECK_EQUAL(
+		jsonCompactPrint(ASTBinaryConverter::toJson(binary)),
+		jsonCompactPrint(result["sources"]["a.sol"]["ast"])
+	);
+
+	// The wildcard does not select the binary AST.
+	result = compile(R"({
+		"language": "Solidity",
+		"sources": { "a.sol": { "content": "contract A {}" } },
+		"settings": { "outputSelection": { "*": { "": ["*"] } } }
+	})");
+	BOOST_CHECK(result["sources"]["a.sol"]["ast"].isObject());
+	BOOST_CHECK(!result["sources"]["a.sol"].isMember("astBinary"));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_matches_json_output)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a.sol": {
+				"content": "contract A { function f() public pure returns (uint) { return 1; } } contract B {}"
+			},
+			"a.sol2": {
+				"content": "import \"a.sol\"; contract C is A { uint x; function g() public { x = f(); } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": ["*"],
+					"": ["ast", "legacyAST"]
+				}
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+
+	dev::solidity::StandardCompiler compiler;
+	string const expectation = jsonCompactPrint(compiler.compile(parsedInput));
+	BOOST_CHECK_EQUAL(compiler.compile(string(input)), expectation);
+
+	ostringstream streamed;
+	BOOST_REQUIRE(compiler.compile(string(input), streamed));
+	BOOST_CHECK_EQUAL(streamed.str(), expectation);
+
+	Json::Value result;
+	BOOST_REQUIRE(jsonParseStrict(streamed.str(), result));
+	BOOST_CHECK(result["contracts"]["a.sol"]["A"].isObject());
+	BOOST_CHECK(result["contracts"]["a.sol2"]["C"].isObject());
+	BOOST_CHECK(result["sources"]["a.sol2"]["ast"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_errors)
+{
+	dev::solidity::StandardCompiler compiler;
+
+	ostringstream invalidJson;
+	BOOST_REQUIRE(compiler.compile("invalid", invalidJson));
+	BOOST_CHECK_EQUAL(invalidJson.str(), compiler.compile(string("invalid")));
+
+	ostringstream invalidLanguage;
+	BOOST_REQUIRE(compiler.compile("{\"language\": \"INVALID\", \"sources\": {\"\": {\"content\": \"\"}}}", invalidLanguage));
+	Json::Value result;
+	BOOST_REQUIRE(jsonParseStrict(invalidLanguage.str(), result));
+	BOOST_CHECK(containsError(result, "JSONError", "Only \"Solidity\" or \"Yul\" is supported as a language."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
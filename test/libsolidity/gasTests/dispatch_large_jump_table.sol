@@ -0,0 +1,55 @@
+contract Large {
+    uint public a;
+    uint[] public b;
+    function f1(uint x) public returns (uint) { a = x; b[uint8(msg.data[0])] = x; }
+    function f2(uint x) public returns (uint) { b[uint8(msg.data[1])] = x; }
+    function f3(uint x) public returns (uint) { b[uint8(msg.data[2])] = x; }
+    function f4(uint x) public returns (uint) { b[uint8(msg.data[3])] = x; }
+    function f5(uint x) public returns (uint) { b[uint8(msg.data[4])] = x; }
+    function f6(uint x) public returns (uint) { b[uint8(msg.data[5])] = x; }
+    function f7(uint x) public returns (uint) { b[uint8(msg.data[6])] = x; }
+    function f8(uint x) public returns (uint) { b[uint8(msg.data[7])] = x; }
+    function f9(uint x) public returns (uint) { b[uint8(msg.data[8])] = x; }
+    function f0(uint x) public pure returns (uint) { require(x > 10); }
+    function g1(uint x) public payable returns (uint) { a = x; b[uint8(msg.data[0])] = x; }
+    function g2(uint x) public payable returns (uint) { b[uint8(msg.data[1])] = x; }
+    function g3(uint x) public payable returns (uint) { b[uint8(msg.data[2])] = x; }
+    function g4(uint x) public payable returns (uint) { b[uint8(msg.data[3])] = x; }
+    function g5(uint x) public payable returns (uint) { b[uint8(msg.data[4])] = x; }
+    function g6(uint x) public payable returns (uint) { b[uint8(msg.data[5])] = x; }
+    function g7(uint x) public payable returns (uint) { b[uint8(msg.data[6])] = x; }
+    function g8(uint x) public payable returns (uint) { b[uint8(msg.data[7])] = x; }
+    function g9(uint x) public payable returns (uint) { b[uint8(msg.data[8])] = x; }
+    function g0(uint x) public payable returns (uint) { require(x > 10); }
+}
+// ====
+// optimize: true
+// optimize-runs: 100000
+// ----
+// creation:
+//   codeDepositCost: 307400
+//   executionCost: 349
+//   totalCost: 307749
+// external:
+//   a(): 424
+//   b(uint256): 757
+//   f0(uint256): 294
+//   f1(uint256): 40614
+//   f2(uint256): 20614
+//   f3(uint256): 20614
+//   f4(uint256): 20636
+//   f5(uint256): 20658
+//   f6(uint256): 20636
+//   f7(uint256): 20614
+//   f8(uint256): 20614
+//   f9(uint256): 20614
+//   g0(uint256): 270
+//   g1(uint256): 40590
+//   g2(uint256): 20590
+//   g3(uint256): 20590
+//   g4(uint256): 20612
+//   g5(uint256): 20590
+//   g6(uint256): 20590
+//   g7(uint256): 20590
+//   g8(uint256): 20590
+//   g9(uint256): 20590
@@ -0,0 +1,30 @@
+contract C {
+	function a() public pure returns (uint) { return 1; }
+	function b() public pure returns (uint) { return 2; }
+	function c() public pure returns (uint) { return 3; }
+	function d() public pure returns (uint) { return 4; }
+	function e() public pure returns (uint) { return 5; }
+	function f() public pure returns (uint) { return 6; }
+	function g() public pure returns (uint) { return 7; }
+	function h() public pure returns (uint) { return 8; }
+	function i() public pure returns (uint) { return 9; }
+	function j() public pure returns (uint) { return 10; }
+	function k() public pure returns (uint) { return 11; }
+	function l() public pure returns (uint) { return 12; }
+}
+// ====
+// compileViaYul: true
+// ----
+// a() -> 1
+// b() -> 2
+// c() -> 3
+// d() -> 4
+// e() -> 5
+// f() -> 6
+// g() -> 7
+// h() -> 8
+// i() -> 9
+// j() -> 10
+// k() -> 11
+// l() -> 12
+// m() -> FAILURE
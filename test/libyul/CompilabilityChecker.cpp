@@ -46,6 +46,23 @@ string check(string const& _input)
 		out += function.first.str() + ": " + to_string(function.second) + " ";
 	return out;
 }
+
+string checkFunctions(string const& _input, set<YulString> const& _functions)
+{
+	Object obj;
+	std::tie(obj.code, obj.analysisInfo) = yul::test::parse(_input, false);
+	BOOST_REQUIRE(obj.code);
+	map<YulString, int> functions = CompilabilityChecker::run(
+		EVMDialect::strictAssemblyForEVM(dev::test::Options::get().evmVersion()),
+		obj,
+		true,
+		_functions
+	);
+	string out;
+	for (auto const& function: functions)
+		out += function.first.str() + ": " + to_string(function.second) + " ";
+	return out;
+}
 }
 
 BOOST_AUTO_TEST_SUITE(CompilabilityChecker)
@@ -220,6 +237,65 @@ BOOST_AUTO_TEST_CASE(also_in_outer_block)
 	BOOST_CHECK_EQUAL(out, ": 9 ");
 }
 
+BOOST_AUTO_TEST_CASE(subset_of_functions)
+{
+	string code = R"({
+		{
+			let x := 0
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			x := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+			pop(h(x))
+		}
+		function f(a, b) -> r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19 {
+		}
+		function g(r1, r2, r3, r4, r5, r6, r7, r8, r9, r10, r11, r12, r13, r14, r15, r16, r17, r18, r19) -> x, y {
+		}
+		function h(x) -> y {
+			let r1 := 0
+			let r2 := 0
+			let r3 := 0
+			let r4 := 0
+			let r5 := 0
+			let r6 := 0
+			let r7 := 0
+			let r8 := 0
+			let r9 := 0
+			let r10 := 0
+			let r11 := 0
+			let r12 := 0
+			let r13 := 0
+			let r14 := 0
+			let r15 := 0
+			let r16 := 0
+			let r17 := 0
+			let r18 := 0
+			y := add(add(add(add(add(add(add(add(add(add(add(add(x, r12), r11), r10), r9), r8), r7), r6), r5), r4), r3), r2), r1)
+		}
+	})";
+	BOOST_CHECK_EQUAL(check(code), ": 9 ");
+	BOOST_CHECK_EQUAL(checkFunctions(code, {YulString{}, YulString{"g"}}), ": 9 ");
+	BOOST_CHECK_EQUAL(checkFunctions(code, {YulString{"h"}}), "h: 10 ");
+	BOOST_CHECK_EQUAL(checkFunctions(code, {YulString{"f"}, YulString{"g"}, YulString{"h"}}), "h: 10 g: 5 f: 5 ");
+	BOOST_CHECK_EQUAL(checkFunctions(code, {}), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
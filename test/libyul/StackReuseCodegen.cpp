@@ -72,7 +72,7 @@ BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code)
 BOOST_AUTO_TEST_CASE(single_var_assigned_plus_code_and_reused)
 {
 	string out = assemble("{ let x := 1 mstore(3, 4) pop(mload(x)) }");
-	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE DUP1 MLOAD POP POP ");
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x1 PUSH1 0x4 PUSH1 0x3 MSTORE MLOAD POP ");
 }
 
 BOOST_AUTO_TEST_CASE(multi_reuse_single_slot)
@@ -92,7 +92,7 @@ BOOST_AUTO_TEST_CASE(multi_reuse_same_variable_name)
 	string out = assemble("{ let z := mload(0) { let x := 1 x := 6 z := x } { let x := 2 z := x x := 4 } }");
 	BOOST_CHECK_EQUAL(out,
 		"PUSH1 0x0 MLOAD "
-		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP DUP1 SWAP2 POP POP "
+		"PUSH1 0x1 PUSH1 0x6 SWAP1 POP SWAP1 POP "
 		"PUSH1 0x2 DUP1 SWAP2 POP PUSH1 0x4 SWAP1 POP POP "
 		"POP "
 	);
@@ -337,8 +337,8 @@ BOOST_AUTO_TEST_CASE(reuse_slots_function_with_gaps)
 		// stack: d c x3 a b
 		"POP "
 		// stack: d c x3 a
-		"DUP1 DUP3 MSTORE "
-		"POP POP "
+		"DUP2 MSTORE " // a is consumed
+		"POP "
 		// stack: d c
 		"DUP2 DUP2 MSTORE "
 		"POP POP "
@@ -346,6 +346,42 @@ BOOST_AUTO_TEST_CASE(reuse_slots_function_with_gaps)
 }
 
 
+BOOST_AUTO_TEST_CASE(consume_last_reference)
+{
+	string out = assemble("{ let x := mload(0) let y := add(1, x) sstore(2, y) }");
+	// Both x and y are on top of the stack at their last reference and are not copied.
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x0 MLOAD PUSH1 0x1 ADD PUSH1 0x2 SSTORE ");
+	// Arguments are evaluated from right to left, so x is not on top of the stack anymore.
+	out = assemble("{ let x := mload(0) sstore(x, 2) }");
+	BOOST_CHECK_EQUAL(out, "PUSH1 0x0 MLOAD PUSH1 0x2 DUP2 SSTORE POP ");
+}
+
+BOOST_AUTO_TEST_CASE(no_consume_in_for_loop_condition)
+{
+	string out = assemble("{ for { let i := calldataload(0) } i { } { mstore(0, 1) } }");
+	BOOST_CHECK_EQUAL(out,
+		"PUSH1 0x0 CALLDATALOAD "
+		"JUMPDEST DUP1 ISZERO PUSH1 0x12 JUMPI "
+		"PUSH1 0x1 PUSH1 0x0 MSTORE "
+		"JUMPDEST PUSH1 0x3 JUMP "
+		"JUMPDEST POP "
+	);
+}
+
+BOOST_AUTO_TEST_CASE(no_consume_above_unused_slot)
+{
+	// a is unused after the mstore. Consuming b in the condition would move the
+	// unused slot of a to the top of the stack inside the body of the if statement.
+	string out = assemble("{ let a := calldataload(0) let b := calldataload(1) mstore(0, a) if b { sstore(0, 1) } }");
+	BOOST_CHECK_EQUAL(out,
+		"PUSH1 0x0 CALLDATALOAD PUSH1 0x1 CALLDATALOAD "
+		"DUP2 PUSH1 0x0 MSTORE "
+		"DUP1 ISZERO PUSH1 0x14 JUMPI "
+		"PUSH1 0x1 PUSH1 0x0 SSTORE "
+		"JUMPDEST POP POP "
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -58,8 +58,10 @@ IsolTestOptions::IsolTestOptions(std::string* _editor):
 	options.add_options()
 		("editor", po::value<std::string>(_editor)->default_value(editorPath()), "Path to editor for opening test files.")
 		("help", po::bool_switch(&showHelp), "Show this help screen.")
+		("jobs,j", po::value<size_t>(&jobs)->default_value(1), "Number of test cases to run in parallel. Failing tests are not handled interactively if this is greater than one.")
 		("no-color", po::bool_switch(&noColor), "Don't use colors.")
-		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.");
+		("test,t", po::value<std::string>(&testFilter)->default_value("*/*"), "Filters which test units to include.")
+		("timing", po::bool_switch(&timing), "Print the test cases that took the longest time to run.");
 }
 
 bool IsolTestOptions::parse(int _argc, char const* const* _argv)
@@ -84,6 +86,10 @@ void IsolTestOptions::validate() const
 		ConfigException,
 		"Invalid test unit filter - can only contain '" + filterString + ": " + testFilter
 	);
+	assertThrow(jobs > 0, ConfigException, "The number of jobs has to be at least one.");
+#if defined(_WIN32)
+	assertThrow(jobs == 1, ConfigException, "Running tests in parallel is not supported on Windows.");
+#endif
 }
 
 }
@@ -33,6 +33,11 @@ struct IsolTestOptions: CommonOptions
 	bool showHelp = false;
 	bool noColor = false;
 	std::string testFilter = std::string{};
+	/// Number of test cases to run in parallel. Failing tests are only reported (not handled
+	/// interactively) if this is greater than one.
+	size_t jobs = 1;
+	/// Report the test cases that took the longest time to run.
+	bool timing = false;
 
 	IsolTestOptions(std::string* _editor);
 	bool parse(int _argc, char const* const* _argv) override;
@@ -29,14 +29,21 @@
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include <queue>
 #include <regex>
 
 #if defined(_WIN32)
 #include <windows.h>
+#else
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 using namespace dev;
@@ -50,17 +57,21 @@ namespace fs = boost::filesystem;
 using TestCreator = TestCase::TestCaseCreator;
 using TestOptions = dev::test::IsolTestOptions;
 
+using TestTiming = pair<string, chrono::microseconds>;
+
 struct TestStats
 {
 	int successCount = 0;
 	int testCount = 0;
 	int skippedCount = 0;
+	vector<TestTiming> timings = {};
 	operator bool() const noexcept { return successCount + skippedCount == testCount; }
-	TestStats& operator+=(TestStats const& _other) noexcept
+	TestStats& operator+=(TestStats const& _other)
 	{
 		successCount += _other.successCount;
 		testCount += _other.testCount;
 		skippedCount += _other.skippedCount;
+		timings += _other.timings;
 		return *this;
 	}
 };
@@ -112,7 +123,8 @@ public:
 		Skipped
 	};
 
-	Result process();
+	/// Runs the test case (if it matches the filter) and prints the results to @a _stream.
+	Result process(ostream& _stream = cout);
 
 	static TestStats processPath(
 		TestCreator _testCaseCreator,
@@ -132,6 +144,21 @@ private:
 
 	Request handleResponse(bool _exception);
 
+	/// @returns the paths of all test files below @a _path, relative to @a _basepath.
+	static vector<fs::path> collectTestPaths(fs::path const& _basepath, fs::path const& _path);
+
+#if !defined(_WIN32)
+	/// Runs the test cases in up to `_options.jobs` child processes and prints their buffered
+	/// output in the order of @a _paths. Processes are used instead of threads, since the
+	/// compiler relies on global state (e.g. TypeProvider and YulStringRepository).
+	static TestStats processPathsInParallel(
+		TestCreator _testCaseCreator,
+		TestOptions const& _options,
+		fs::path const& _basepath,
+		vector<fs::path> const& _paths
+	);
+#endif
+
 	TestCreator m_testCaseCreator;
 	TestOptions const& m_options;
 	TestFilter m_filter;
@@ -146,7 +173,7 @@ private:
 string TestTool::editor;
 bool TestTool::m_exitRequested = false;
 
-TestTool::Result TestTool::process()
+TestTool::Result TestTool::process(ostream& _stream)
 {
 	bool formatted{!m_options.noColor};
 	std::stringstream outputMessages;
@@ -155,28 +182,28 @@ TestTool::Result TestTool::process()
 	{
 		if (m_filter.matches(m_name))
 		{
-			(AnsiColorized(cout, formatted, {BOLD}) << m_name << ": ").flush();
+			(AnsiColorized(_stream, formatted, {BOLD}) << m_name << ": ").flush();
 
 			m_test = m_testCaseCreator(TestCase::Config{m_path.string(), m_options.evmVersion()});
 			if (m_test->validateSettings(m_options.evmVersion()))
 				switch (TestCase::TestResult result = m_test->run(outputMessages, "  ", formatted))
 				{
 					case TestCase::TestResult::Success:
-						AnsiColorized(cout, formatted, {BOLD, GREEN}) << "OK" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, GREEN}) << "OK" << endl;
 						return Result::Success;
 					default:
-						AnsiColorized(cout, formatted, {BOLD, RED}) << "FAIL" << endl;
+						AnsiColorized(_stream, formatted, {BOLD, RED}) << "FAIL" << endl;
 
-						AnsiColorized(cout, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
-						m_test->printSource(cout, "    ", formatted);
-						m_test->printUpdatedSettings(cout, "    ", formatted);
+						AnsiColorized(_stream, formatted, {BOLD, CYAN}) << "  Contract:" << endl;
+						m_test->printSource(_stream, "    ", formatted);
+						m_test->printUpdatedSettings(_stream, "    ", formatted);
 
-						cout << endl << outputMessages.str() << endl;
+						_stream << endl << outputMessages.str() << endl;
 						return result == TestCase::TestResult::FatalError ? Result::Exception : Result::Failure;
 				}
 			else
 			{
-				AnsiColorized(cout, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
+				AnsiColorized(_stream, formatted, {BOLD, YELLOW}) << "NOT RUN" << endl;
 				return Result::Skipped;
 			}
 		}
@@ -185,13 +212,13 @@ TestTool::Result TestTool::process()
 	}
 	catch (boost::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test: " << boost::diagnostic_information(_e) << endl;
 		return Result::Exception;
 	}
 	catch (std::exception const& _e)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Exception during test" <<
 			(_e.what() ? ": " + string(_e.what()) : ".") <<
 			endl;
@@ -199,7 +226,7 @@ TestTool::Result TestTool::process()
 	}
 	catch (...)
 	{
-		AnsiColorized(cout, formatted, {BOLD, RED}) <<
+		AnsiColorized(_stream, formatted, {BOLD, RED}) <<
 			"Unknown exception during test." << endl;
 		return Result::Exception;
 	}
@@ -247,27 +274,20 @@ TestTool::Request TestTool::handleResponse(bool _exception)
 	}
 }
 
-TestStats TestTool::processPath(
-	TestCreator _testCaseCreator,
-	TestOptions const& _options,
-	fs::path const& _basepath,
-	fs::path const& _path
-)
+vector<fs::path> TestTool::collectTestPaths(fs::path const& _basepath, fs::path const& _path)
 {
+	vector<fs::path> testPaths;
 	std::queue<fs::path> paths;
 	paths.push(_path);
-	int successCount = 0;
-	int testCount = 0;
-	int skippedCount = 0;
 
 	while (!paths.empty())
 	{
 		auto currentPath = paths.front();
+		paths.pop();
 
 		fs::path fullpath = _basepath / currentPath;
 		if (fs::is_directory(fullpath))
 		{
-			paths.pop();
 			for (auto const& entry: boost::iterator_range<fs::directory_iterator>(
 				fs::directory_iterator(fullpath),
 				fs::directory_iterator()
@@ -275,10 +295,41 @@ TestStats TestTool::processPath(
 				if (fs::is_directory(entry.path()) || TestCase::isTestFilename(entry.path().filename()))
 					paths.push(currentPath / entry.path().filename());
 		}
-		else if (m_exitRequested)
+		else
+			testPaths.push_back(currentPath);
+	}
+
+	return testPaths;
+}
+
+TestStats TestTool::processPath(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	fs::path const& _path
+)
+{
+	vector<fs::path> const testPaths = collectTestPaths(_basepath, _path);
+
+#if !defined(_WIN32)
+	if (_options.jobs > 1)
+		return processPathsInParallel(_testCaseCreator, _options, _basepath, testPaths);
+#endif
+
+	int successCount = 0;
+	int testCount = 0;
+	int skippedCount = 0;
+	vector<TestTiming> timings;
+
+	size_t index = 0;
+	while (index < testPaths.size())
+	{
+		auto const& currentPath = testPaths[index];
+
+		if (m_exitRequested)
 		{
 			++testCount;
-			paths.pop();
+			++index;
 		}
 		else
 		{
@@ -286,10 +337,16 @@ TestStats TestTool::processPath(
 			TestTool testTool(
 				_testCaseCreator,
 				_options,
-				fullpath,
+				_basepath / currentPath,
 				currentPath.string()
 			);
+			auto start = chrono::steady_clock::now();
 			auto result = testTool.process();
+			if (result != Result::Skipped)
+				timings.emplace_back(
+					currentPath.string(),
+					chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start)
+				);
 
 			switch(result)
 			{
@@ -298,34 +355,172 @@ TestStats TestTool::processPath(
 				switch(testTool.handleResponse(result == Result::Exception))
 				{
 				case Request::Quit:
-					paths.pop();
+					++index;
 					m_exitRequested = true;
 					break;
 				case Request::Rerun:
 					cout << "Re-running test case..." << endl;
 					--testCount;
+					timings.pop_back();
 					break;
 				case Request::Skip:
-					paths.pop();
+					++index;
 					++skippedCount;
 					break;
 				}
 				break;
 			case Result::Success:
-				paths.pop();
+				++index;
 				++successCount;
 				break;
 			case Result::Skipped:
-				paths.pop();
+				++index;
 				++skippedCount;
 				break;
 			}
 		}
 	}
 
-	return { successCount, testCount, skippedCount };
+	return { successCount, testCount, skippedCount, move(timings) };
+}
+
+#if !defined(_WIN32)
+TestStats TestTool::processPathsInParallel(
+	TestCreator _testCaseCreator,
+	TestOptions const& _options,
+	fs::path const& _basepath,
+	vector<fs::path> const& _paths
+)
+{
+	struct Job
+	{
+		size_t index;
+		pid_t pid;
+		int fd;
+		string output;
+	};
+	struct JobResult
+	{
+		Result result;
+		chrono::microseconds duration;
+		string output;
+	};
+
+	TestFilter filter{_options.testFilter};
+	vector<boost::optional<JobResult>> results(_paths.size());
+	vector<Job> running;
+	size_t next = 0;
+	size_t printed = 0;
+	TestStats stats;
 
+	while (printed < _paths.size())
+	{
+		while (running.size() < _options.jobs && next < _paths.size())
+		{
+			size_t index = next++;
+			string name = _paths[index].string();
+			if (!filter.matches(name))
+			{
+				results[index] = JobResult{Result::Skipped, {}, {}};
+				continue;
+			}
+
+			int fds[2];
+			if (pipe(fds) != 0)
+				BOOST_THROW_EXCEPTION(runtime_error("Could not create pipe: " + string(strerror(errno))));
+			cout.flush();
+			pid_t pid = fork();
+			if (pid < 0)
+				BOOST_THROW_EXCEPTION(runtime_error("Could not start test process: " + string(strerror(errno))));
+			if (pid == 0)
+			{
+				close(fds[0]);
+				ostringstream output;
+				auto start = chrono::steady_clock::now();
+				Result result = TestTool(_testCaseCreator, _options, _basepath / _paths[index], name).process(output);
+				auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+				string message =
+					to_string(static_cast<int>(result)) + " " +
+					to_string(duration.count()) + "\n" +
+					output.str();
+				for (size_t written = 0; written < message.size();)
+				{
+					ssize_t count = write(fds[1], message.data() + written, message.size() - written);
+					if (count < 0 && errno != EINTR)
+						_exit(1);
+					written += size_t(max<ssize_t>(count, 0));
+				}
+				_exit(0);
+			}
+			close(fds[1]);
+			running.push_back(Job{index, pid, fds[0], {}});
+		}
+
+		if (!running.empty())
+		{
+			vector<pollfd> pollFds;
+			for (Job const& job: running)
+				pollFds.push_back(pollfd{job.fd, POLLIN, 0});
+			if (poll(pollFds.data(), pollFds.size(), -1) < 0 && errno != EINTR)
+				BOOST_THROW_EXCEPTION(runtime_error("Error waiting for test processes: " + string(strerror(errno))));
+
+			for (size_t i = pollFds.size(); i-- > 0;)
+			{
+				if (!pollFds[i].revents)
+					continue;
+				Job& job = running[i];
+				char buffer[4096];
+				ssize_t count = read(job.fd, buffer, sizeof(buffer));
+				if (count > 0)
+					job.output.append(buffer, size_t(count));
+				else if (count == 0 || errno != EINTR)
+				{
+					close(job.fd);
+					int status = 0;
+					waitpid(job.pid, &status, 0);
+
+					JobResult jobResult{Result::Exception, {}, {}};
+					size_t headerEnd = job.output.find('\n');
+					if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && headerEnd != string::npos)
+					{
+						istringstream header(job.output.substr(0, headerEnd));
+						int result = 0;
+						chrono::microseconds::rep duration = 0;
+						header >> result >> duration;
+						jobResult = JobResult{Result(result), chrono::microseconds(duration), job.output.substr(headerEnd + 1)};
+					}
+					else
+					{
+						ostringstream output;
+						output << _paths[job.index].string() << ": ";
+						AnsiColorized(output, !_options.noColor, {BOLD, RED}) <<
+							"Test process terminated abnormally." << endl;
+						jobResult.output = output.str();
+					}
+					results[job.index] = move(jobResult);
+					running.erase(running.begin() + ptrdiff_t(i));
+				}
+			}
+		}
+
+		for (; printed < _paths.size() && results[printed]; ++printed)
+		{
+			JobResult const& jobResult = *results[printed];
+			cout << jobResult.output;
+			++stats.testCount;
+			if (jobResult.result == Result::Success)
+				++stats.successCount;
+			else if (jobResult.result == Result::Skipped)
+				++stats.skippedCount;
+			if (jobResult.result != Result::Skipped)
+				stats.timings.emplace_back(_paths[printed].string(), jobResult.duration);
+			results[printed].reset();
+		}
+	}
+
+	return stats;
 }
+#endif
 
 namespace
 {
@@ -350,6 +545,21 @@ void setupTerminal()
 #endif
 }
 
+void printSlowestTests(vector<TestTiming> _timings, bool _formatted)
+{
+	size_t const count = min<size_t>(_timings.size(), 20);
+	partial_sort(_timings.begin(), _timings.begin() + ptrdiff_t(count), _timings.end(), [](TestTiming const& _a, TestTiming const& _b) {
+		return _a.second > _b.second;
+	});
+
+	cout << endl;
+	AnsiColorized(cout, _formatted, {BOLD}) << "Slowest test cases:" << endl;
+	for (size_t i = 0; i < count; ++i)
+		cout <<
+			setw(10) << fixed << setprecision(3) << (double(_timings[i].second.count()) / 1000) << " ms  " <<
+			_timings[i].first << endl;
+}
+
 boost::optional<TestStats> runTestSuite(
 	TestCreator _testCaseCreator,
 	TestOptions const& _options,
@@ -414,14 +624,8 @@ int main(int argc, char const *argv[])
 		return 1;
 	}
 
-	bool disableSemantics = !dev::test::EVMHost::getVM(options.evmonePath.string());
-	if (disableSemantics)
-	{
-		cout << "Unable to find libevmone.so. Please provide the path using --evmonepath <path>." << endl;
-		cout << "You can download it at" << endl;
-		cout << "https://github.com/ethereum/evmone/releases/download/v0.1.0/evmone-0.1.0-linux-x86_64.tar.gz" << endl;
-		cout << endl << "--- SKIPPING ALL SEMANTICS TESTS ---" << endl << endl;
-	}
+	// Select the VM: libevmone if it can be found, the built-in interpreter otherwise.
+	dev::test::EVMHost::getVM(options.evmonePath.string());
 
 	TestStats global_stats{0, 0};
 	cout << "Running tests..." << endl << endl;
@@ -430,9 +634,6 @@ int main(int argc, char const *argv[])
 	// Interactive tests are added in InteractiveTests.h
 	for (auto const& ts: g_interactiveTestsuites)
 	{
-		if (ts.needsVM && disableSemantics)
-			continue;
-
 		if (ts.smt && options.disableSMT)
 			continue;
 
@@ -461,8 +662,8 @@ int main(int argc, char const *argv[])
 	}
 	cout << "." << endl;
 
-	if (disableSemantics)
-		cout << "\nNOTE: Skipped semantics tests because libevmone.so could not be found.\n" << endl;
+	if (options.timing)
+		printSlowestTests(global_stats.timings, !options.noColor);
 
 	return global_stats ? 0 : 1;
 }